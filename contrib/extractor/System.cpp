@@ -788,7 +788,8 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
                     liquid_height[y][x] = CONF_use_minHeight;
             }
         }
-        map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
+        // keep liquid data 4 bytes aligned, so server can use float array directly from mapped file
+        map.liquidMapOffset = (map.heightMapOffset + map.heightMapSize + 3) & ~3;
         map.liquidMapSize = sizeof(map_liquidHeader);
         liquidHeader.fourcc = *(uint32 const*)MAP_LIQUID_MAGIC;
         liquidHeader.flags = 0;
@@ -855,6 +856,9 @@ bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
+        static uint8 const padding[4] = { 0, 0, 0, 0 };
+        fwrite(padding, 1, map.liquidMapOffset - (map.heightMapOffset + map.heightMapSize), output);
+
         fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
         if (!(liquidHeader.flags&MAP_LIQUID_NO_TYPE))
             fwrite(liquid_type, sizeof(liquid_type), 1, output);
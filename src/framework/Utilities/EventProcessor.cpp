@@ -18,15 +18,36 @@
 
 #include "EventProcessor.h"
 
+#include <algorithm>
+
+// heap order: earliest execution time first, then add order
+struct EventExecOrder
+{
+    bool operator()(BasicEvent const* a, BasicEvent const* b) const
+    {
+        if (a->m_execTime != b->m_execTime)
+            return a->m_execTime > b->m_execTime;
+
+        return int32(a->m_eventSeq - b->m_eventSeq) > 0;
+    }
+};
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_wheel = NULL;
+    m_overflow = NULL;
+    m_wheelTick = 0;
+    m_levelCount[0] = 0;
+    m_levelCount[1] = 0;
+    m_nextSeq = 0;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    delete[] m_wheel;
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -34,13 +55,15 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    CollectDueEvents();
+
+    // main event loop, events added in loop with already passed time are executed in same update
+    while (!m_dueEvents.empty())
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        std::pop_heap(m_dueEvents.begin(), m_dueEvents.end(), EventExecOrder());
+        BasicEvent* Event = m_dueEvents.back();
+        m_dueEvents.pop_back();
 
         if (!Event->to_Abort)
         {
@@ -58,31 +81,68 @@ void EventProcessor::Update(uint32 p_time)
     }
 }
 
+void EventProcessor::KillEventList(BasicEvent*& head, bool force)
+{
+    // detach list first, Abort calls can add new events
+    BasicEvent* Event = head;
+    head = NULL;
+
+    while (Event)
+    {
+        BasicEvent* next = Event->m_nextEvent;
+
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
+            delete Event;
+        else
+        {
+            // need per-element cleanup, keep event until its execution time
+            Event->m_nextEvent = head;
+            head = Event;
+        }
+
+        Event = next;
+    }
+}
+
 void EventProcessor::KillAllEvents(bool force)
 {
     // prevent event insertions
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    EventList dueEvents;
+    dueEvents.swap(m_dueEvents);
+    for (EventList::iterator i = dueEvents.begin(); i != dueEvents.end(); ++i)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        (*i)->to_Abort = true;
+        (*i)->Abort(m_time);
+        if (force || (*i)->IsDeletable())
+            delete *i;
+        else
+            AddDueEvent(*i);
+    }
+
+    if (m_wheel)
+        for (int i = 0; i < 2 * EVENT_WHEEL_SLOTS; ++i)
+            KillEventList(m_wheel[i], force);
+
+    KillEventList(m_overflow, force);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+    // Abort calls can add events to already processed slots, so count kept events only after full sweep
+    if (m_wheel)
+    {
+        for (int level = 0; level < 2; ++level)
         {
-            delete i_old->second;
+            uint32 count = 0;
+            for (int i = level * EVENT_WHEEL_SLOTS; i < (level + 1) * EVENT_WHEEL_SLOTS; ++i)
+                for (BasicEvent* Event = m_wheel[i]; Event; Event = Event->m_nextEvent)
+                    ++count;
 
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            m_levelCount[level] = count;
         }
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -91,10 +151,126 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_eventSeq = m_nextSeq++;
+
+    if (e_time <= m_time)
+        AddDueEvent(Event);
+    else
+        InsertToWheel(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::AddDueEvent(BasicEvent* Event)
+{
+    m_dueEvents.push_back(Event);
+    std::push_heap(m_dueEvents.begin(), m_dueEvents.end(), EventExecOrder());
+}
+
+void EventProcessor::InsertToWheel(BasicEvent* Event)
+{
+    if (!m_wheel)
+        m_wheel = new BasicEvent*[2 * EVENT_WHEEL_SLOTS]();
+
+    uint64 tick = std::max(Event->m_execTime >> EVENT_TICK_BITS, m_wheelTick);
+
+    BasicEvent** slot;
+    if (tick - m_wheelTick < EVENT_WHEEL_SLOTS)
+    {
+        slot = &m_wheel[tick & EVENT_WHEEL_MASK];
+        ++m_levelCount[0];
+    }
+    else if ((tick >> EVENT_WHEEL_BITS) - (m_wheelTick >> EVENT_WHEEL_BITS) < EVENT_WHEEL_SLOTS)
+    {
+        slot = &m_wheel[EVENT_WHEEL_SLOTS + ((tick >> EVENT_WHEEL_BITS) & EVENT_WHEEL_MASK)];
+        ++m_levelCount[1];
+    }
+    else
+        slot = &m_overflow;
+
+    Event->m_nextEvent = *slot;
+    *slot = Event;
+}
+
+void EventProcessor::Cascade()
+{
+    // level 1 slot of new level 0 turn, all its events fit in level 0 now
+    BasicEvent*& head = m_wheel[EVENT_WHEEL_SLOTS + ((m_wheelTick >> EVENT_WHEEL_BITS) & EVENT_WHEEL_MASK)];
+    BasicEvent* Event = head;
+    head = NULL;
+
+    while (Event)
+    {
+        BasicEvent* next = Event->m_nextEvent;
+        --m_levelCount[1];
+        InsertToWheel(Event);
+        Event = next;
+    }
+
+    // far events are rare, recheck them once per level 0 turn
+    Event = m_overflow;
+    m_overflow = NULL;
+
+    while (Event)
+    {
+        BasicEvent* next = Event->m_nextEvent;
+        InsertToWheel(Event);
+        Event = next;
+    }
+}
+
+void EventProcessor::CollectDueEvents()
+{
+    if (!m_wheel)
+    {
+        m_wheelTick = m_time >> EVENT_TICK_BITS;
+        return;
+    }
+
+    uint64 targetTick = m_time >> EVENT_TICK_BITS;
+
+    while (true)
+    {
+        // skip to next level 0 turn if nothing left in level 0
+        if (!m_levelCount[0] && m_wheelTick < targetTick)
+        {
+            uint64 nextTurn = (m_wheelTick | EVENT_WHEEL_MASK) + 1;
+            if (nextTurn > targetTick)
+            {
+                m_wheelTick = targetTick;
+                break;
+            }
+
+            m_wheelTick = nextTurn;
+            Cascade();
+            continue;
+        }
+
+        BasicEvent** link = &m_wheel[m_wheelTick & EVENT_WHEEL_MASK];
+
+        // events of current tick can be planned a bit later in the same tick
+        bool currentTick = m_wheelTick == targetTick;
+
+        while (BasicEvent* Event = *link)
+        {
+            if (!currentTick || Event->m_execTime <= m_time)
+            {
+                *link = Event->m_nextEvent;
+                --m_levelCount[0];
+                AddDueEvent(Event);
+            }
+            else
+                link = &Event->m_nextEvent;
+        }
+
+        if (currentTick)
+            break;
+
+        ++m_wheelTick;
+        if (!(m_wheelTick & EVENT_WHEEL_MASK))
+            Cascade();
+    }
+}
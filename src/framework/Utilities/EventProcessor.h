@@ -21,16 +21,19 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
+    friend class EventProcessor;
+    friend struct EventExecOrder;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_nextEvent(NULL), m_eventSeq(0)
         {
         }
 
@@ -53,10 +56,27 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+
+    private:
+        BasicEvent* m_nextEvent;                            // intrusive link in event handler slot list
+        uint32 m_eventSeq;                                  // add order, keep execution order for events with same time
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+typedef std::vector<BasicEvent*> EventList;
+
+#define EVENT_TICK_BITS     6                               // wheel tick is 64 ms
+#define EVENT_WHEEL_BITS    4
+#define EVENT_WHEEL_SLOTS   (1 << EVENT_WHEEL_BITS)         // slots per wheel level
+#define EVENT_WHEEL_MASK    (EVENT_WHEEL_SLOTS - 1)
 
+/**
+ * Two level timing wheel of events.
+ *
+ * Level 0 slots cover one tick each (~1 sec ahead), level 1 slots cover one full level 0 turn
+ * (~16 sec ahead), farther events wait in overflow list. Wheel is small to keep per unit memory low. Events are linked through BasicEvent
+ * itself, so adding event doesn't allocate memory. Due events are moved to small heap sorted
+ * by execution time and add order, events are executed in same order as by time ordered queue.
+ */
 class EventProcessor
 {
     public:
@@ -72,8 +92,21 @@ class EventProcessor
     protected:
 
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        void InsertToWheel(BasicEvent* Event);
+        void AddDueEvent(BasicEvent* Event);
+        void CollectDueEvents();
+        void Cascade();
+        void KillEventList(BasicEvent*& head, bool force);
+
+        EventList m_dueEvents;                              // heap of events with m_execTime <= m_time
+        BasicEvent** m_wheel;                               // level 0 then level 1 slots, allocated at first use
+        BasicEvent* m_overflow;                             // events beyond level 1 range
+        uint64 m_wheelTick;                                 // current tick, all earlier ticks processed
+        uint32 m_levelCount[2];                             // events in wheel levels
+        uint32 m_nextSeq;
 };
 
 #endif
@@ -393,6 +393,7 @@ bool AchievementCriteriaRequirementSet::Meets(Player const* source, Unit const*
 AchievementMgr::AchievementMgr(Player *player)
 {
     m_player = player;
+    m_completedCriteria.resize(sAchievementCriteriaStore.GetNumRows(), false);
 }
 
 AchievementMgr::~AchievementMgr()
@@ -417,6 +418,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_completedCriteria.assign(m_completedCriteria.size(), false);
     DeleteFromDB(m_player->GetObjectGuid());
 
     // re-fill data
@@ -576,6 +578,7 @@ void AchievementMgr::LoadFromDB(QueryResult *achievementResult, QueryResult *cri
             progress.date    = date;
             progress.changed = false;
             progress.timedCriteriaFailed = false;
+            UpdateCriteriaCompletedState(criteria, counter);
 
             // A failed achievement will be removed on next tick - TODO: Possible that timer 2 is reseted
             if (criteria->timeLimit)
@@ -809,8 +812,9 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld.getConfig(CONFIG_BOOL_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
-    for(AchievementCriteriaEntryList::const_iterator itr = achievementCriteriaList.begin(); itr != achievementCriteriaList.end(); ++itr)
+    // only criterias that can match miscvalue1 at all, or all for login/full check (miscvalue1 == 0)
+    AchievementCriteriaEntryBounds bounds = sAchievementMgr.GetAchievementCriteriaByTypeAndValue(type, miscvalue1);
+    for(AchievementCriteriaEntryVector::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
     {
         AchievementCriteriaEntry const *achievementCriteria = *itr;
 
@@ -1844,19 +1848,19 @@ bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achieve
             return false;
     }
 
-    CriteriaProgressMap::const_iterator itr = m_criteriaProgress.find(achievementCriteria->ID);
-    if(itr == m_criteriaProgress.end())
-        return false;
+    // cached progress->counter >= max counter state, see UpdateCriteriaCompletedState
+    return achievementCriteria->ID < m_completedCriteria.size() && m_completedCriteria[achievementCriteria->ID];
+}
 
-    CriteriaProgress const* progress = &itr->second;
+void AchievementMgr::UpdateCriteriaCompletedState(AchievementCriteriaEntry const* criteria, uint32 counter)
+{
+    if (criteria->ID >= m_completedCriteria.size())
+        return;
 
-    uint32 maxcounter = GetCriteriaProgressMaxCounter(achievementCriteria);
+    uint32 maxcounter = GetCriteriaProgressMaxCounter(criteria);
 
     // different counters or non-completable criteria
-    if (!maxcounter)
-        return false;
-
-    return progress->counter >= maxcounter;
+    m_completedCriteria[criteria->ID] = maxcounter && counter >= maxcounter;
 }
 
 void AchievementMgr::CompletedCriteriaFor(AchievementEntry const* achievement)
@@ -2007,6 +2011,7 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* criteri
 
     progress->counter = newValue;
     progress->changed = true;
+    UpdateCriteriaCompletedState(criteria, newValue);
 
     // update client side value
     SendCriteriaUpdate(criteria->ID,progress);
@@ -2213,6 +2218,63 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryBounds AchievementGlobalMgr::GetAchievementCriteriaByTypeAndValue(AchievementCriteriaTypes type, uint32 miscvalue1) const
+{
+    AchievementCriteriaEntryVector const& criterias = m_AchievementCriteriasByTypeIndex[type];
+    std::vector<uint32> const& values = m_AchievementCriteriasByTypeIndexValues[type];
+
+    // not indexed type or update without specific value (login or full check)
+    if (values.empty() || !miscvalue1)
+        return AchievementCriteriaEntryBounds(criterias.begin(), criterias.end());
+
+    std::pair<std::vector<uint32>::const_iterator, std::vector<uint32>::const_iterator> range = std::equal_range(values.begin(), values.end(), miscvalue1);
+    return AchievementCriteriaEntryBounds(criterias.begin() + (range.first - values.begin()), criterias.begin() + (range.second - values.begin()));
+}
+
+/// Return criteria field that UpdateAchievementCriteria compare with non-zero miscvalue1 (mismatch always skip criteria)
+bool AchievementGlobalMgr::GetCriteriaIndexValue(AchievementCriteriaEntry const* criteria, uint32& value)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:           value = criteria->kill_creature.creatureID;             return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:       value = criteria->reach_skill_level.skillID;            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:       value = criteria->learn_skill_level.skillID;            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE: value = criteria->complete_quests_in_zone.zoneID;       return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:      value = criteria->killed_by_creature.creatureEntry;     return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:          value = criteria->complete_quest.questID;               return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:        value = criteria->be_spell_target.spellID;              return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:             value = criteria->cast_spell.spellID;                   return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:             value = criteria->learn_spell.spellID;                  return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:               value = criteria->loot_type.lootType;                   return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:               value = criteria->own_item.itemID;                      return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:                value = criteria->use_item.itemID;                      return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:         value = criteria->gain_reputation.factionID;            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:                value = criteria->do_emote.emoteID;                     return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:              value = criteria->equip_item.itemID;                    return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:          value = criteria->use_gameobject.goEntry;               return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:      value = criteria->fish_in_gameobject.goEntry;           return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:  value = criteria->learn_skillline_spell.skillLine;      return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:        value = criteria->learn_skill_line.skillLine;           return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:                value = criteria->hk_class.classID;                     return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:                 value = criteria->hk_race.raceID;                       return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:     value = criteria->highest_team_rating.teamtype;         return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING: value = criteria->highest_personal_rating.teamtype;     return true;
+        default:
+            return false;
+    }
+}
+
+struct AchievementCriteriaIndexValueLess
+{
+    bool operator() (std::pair<uint32, AchievementCriteriaEntry const*> const& a, std::pair<uint32, AchievementCriteriaEntry const*> const& b) const
+    {
+        return a.first < b.first;
+    }
+};
+
 void AchievementGlobalMgr::LoadAchievementCriteriaList()
 {
     if (sAchievementCriteriaStore.GetNumRows()==0)
@@ -2240,6 +2302,39 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
     }
 
+    // build contiguous per type arrays, sorted by compared value for types where it possible
+    for (uint32 type = 0; type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++type)
+    {
+        AchievementCriteriaEntryList const& criteriaList = m_AchievementCriteriasByType[type];
+        AchievementCriteriaEntryVector& criterias = m_AchievementCriteriasByTypeIndex[type];
+        std::vector<uint32>& values = m_AchievementCriteriasByTypeIndexValues[type];
+
+        criterias.assign(criteriaList.begin(), criteriaList.end());
+
+        std::vector<std::pair<uint32, AchievementCriteriaEntry const*> > sorted;
+        sorted.reserve(criterias.size());
+        for (AchievementCriteriaEntryVector::const_iterator itr = criterias.begin(); itr != criterias.end(); ++itr)
+        {
+            uint32 value;
+            if (!GetCriteriaIndexValue(*itr, value))
+                break;                                      // same for all criterias of type
+            sorted.push_back(std::pair<uint32, AchievementCriteriaEntry const*>(value, *itr));
+        }
+
+        // not indexed type
+        if (sorted.empty())
+            continue;
+
+        std::stable_sort(sorted.begin(), sorted.end(), AchievementCriteriaIndexValueLess());
+
+        values.resize(sorted.size());
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            values[i] = sorted[i].first;
+            criterias[i] = sorted[i].second;
+        }
+    }
+
     sLog.outString();
     sLog.outString(">> Loaded %lu achievement criteria.",(unsigned long)m_AchievementCriteriasByType->size());
 }
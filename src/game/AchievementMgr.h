@@ -28,9 +28,12 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
+typedef std::vector<AchievementCriteriaEntry const*> AchievementCriteriaEntryVector;
+typedef std::pair<AchievementCriteriaEntryVector::const_iterator, AchievementCriteriaEntryVector::const_iterator> AchievementCriteriaEntryBounds;
 
 typedef std::map<uint32,AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
 typedef std::map<uint32,AchievementEntryList>         AchievementListByReferencedId;
@@ -302,9 +305,11 @@ class AchievementMgr
         bool IsCompletedAchievement(AchievementEntry const* entry);
         void CompleteAchievementsWithRefs(AchievementEntry const* entry);
         void BuildAllDataPacket(WorldPacket *data);
+        void UpdateCriteriaCompletedState(AchievementCriteriaEntry const* criteria, uint32 counter);
 
         Player* m_player;
         CriteriaProgressMap m_criteriaProgress;
+        std::vector<bool> m_completedCriteria;              // indexed by criteria id, counter reached max counter
         CompletedAchievementMap m_completedAchievements;
         AchievementCriteriaFailTimeMap m_criteriaFailTimes;
 };
@@ -313,6 +318,7 @@ class AchievementGlobalMgr
 {
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type);
+        AchievementCriteriaEntryBounds GetAchievementCriteriaByTypeAndValue(AchievementCriteriaTypes type, uint32 miscvalue1) const;
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id)
         {
             AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -370,8 +376,13 @@ class AchievementGlobalMgr
     private:
         AchievementCriteriaRequirementMap m_criteriaRequirementMap;
 
+        static bool GetCriteriaIndexValue(AchievementCriteriaEntry const* criteria, uint32& value);
+
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // same criterias in contiguous arrays, sorted by the value matched against miscvalue1 for indexed types
+        AchievementCriteriaEntryVector m_AchievementCriteriasByTypeIndex[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        std::vector<uint32> m_AchievementCriteriasByTypeIndexValues[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -952,16 +952,14 @@ bool AuctionBotSeller::Initialize()
 
     uint32 itemsAdded = 0;
 
-    BarGoLink bar(sItemStorage.MaxEntry);
-    for (uint32 itemID = 0; itemID < sItemStorage.MaxEntry; ++itemID)
+    BarGoLink bar(sItemStorage.RecordCount);
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        ItemPrototype const* prototype = sObjectMgr.GetItemPrototype(itemID);
+        ItemPrototype const* prototype = *itr;
+        uint32 itemID = prototype->ItemId;
 
         bar.step();
 
-        if (!prototype)
-            continue;
-
         // skip items with too high quality (code can't propertly work with its)
         if (prototype->Quality >= MAX_AUCTION_QUALITY)
             continue;
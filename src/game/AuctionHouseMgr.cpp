@@ -263,8 +263,11 @@ void AuctionHouseMgr::SendAuctionExpiredMail(AuctionEntry * auction)
 
 void AuctionHouseMgr::LoadAuctionItems()
 {
-    // data needs to be at first place for Item::LoadFromDB 0   1    2        3
-    QueryResult *result = CharacterDatabase.Query("SELECT data,text,itemguid,item_template FROM auction JOIN item_instance ON itemguid = guid");
+    static SqlStatementID loadAuctionItems;
+
+    // data needs to be at first place for Item::LoadFromDB                         0    1    2        3
+    SqlStatement stmt = CharacterDatabase.CreateStatement(loadAuctionItems, "SELECT data,text,itemguid,item_template FROM auction JOIN item_instance ON itemguid = guid");
+    QueryResult *result = stmt.Query();
 
     if (!result)
     {
@@ -339,7 +342,10 @@ void AuctionHouseMgr::LoadAuctions()
         return;
     }
 
-    result = CharacterDatabase.Query("SELECT id,houseid,itemguid,item_template,item_count,item_randompropertyid,itemowner,buyoutprice,time,moneyTime,buyguid,lastbid,startbid,deposit FROM auction");
+    // prepared statement result rows come by binary protocol, without numeric values conversion from text
+    static SqlStatementID loadAuctions;
+    SqlStatement stmt = CharacterDatabase.CreateStatement(loadAuctions, "SELECT id,houseid,itemguid,item_template,item_count,item_randompropertyid,itemowner,buyoutprice,time,moneyTime,buyguid,lastbid,startbid,deposit FROM auction");
+    result = stmt.Query();
     if (!result)
     {
         BarGoLink bar(1);
@@ -564,6 +570,68 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+void AuctionHouseObject::AddAuction(AuctionEntry *ah)
+{
+    MANGOS_ASSERT( ah );
+    AuctionsMap[ah->Id] = ah;
+    CategoryIndex[GetCategoryKey(ah)] = ah;
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    RemoveAuctionFromIndex(itr->second);
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+uint64 AuctionHouseObject::GetCategoryKey(AuctionEntry const* auction)
+{
+    // auctions with unknown item template are kept in index at zero category, search filters will skip them anyway
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return GetCategoryKey(0, 0, 0, auction->Id);
+
+    return GetCategoryKey(proto->Class, proto->SubClass, proto->InventoryType, auction->Id);
+}
+
+void AuctionHouseObject::GetAuctionsByCategory(uint32 itemClass, uint32 itemSubClass, uint32 inventoryType, std::vector<AuctionEntry*>& auctions) const
+{
+    // no category, all auctions
+    if (itemClass == 0xffffffff)
+    {
+        auctions.reserve(AuctionsMap.size());
+        for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+            auctions.push_back(itr->second);
+        return;
+    }
+
+    // index is ordered by class, subclass, inventory type so any prefix of these selects continuous range
+    uint64 lowKey, highKey;
+    if (itemSubClass == 0xffffffff)
+    {
+        lowKey = GetCategoryKey(itemClass, 0, 0);
+        highKey = lowKey | ((uint64(1) << 56) - 1);
+    }
+    else if (inventoryType == 0xffffffff)
+    {
+        lowKey = GetCategoryKey(itemClass, itemSubClass, 0);
+        highKey = lowKey | ((uint64(1) << 48) - 1);
+    }
+    else
+    {
+        lowKey = GetCategoryKey(itemClass, itemSubClass, inventoryType);
+        highKey = lowKey | ((uint64(1) << 40) - 1);
+    }
+
+    AuctionCategoryIndex::const_iterator end = CategoryIndex.upper_bound(highKey);
+    for (AuctionCategoryIndex::const_iterator itr = CategoryIndex.lower_bound(lowKey); itr != end; ++itr)
+        auctions.push_back(itr->second);
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
@@ -578,6 +646,7 @@ void AuctionHouseObject::Update()
 
                 itr->second->DeleteFromDB();
                 MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
+                RemoveAuctionFromIndex(itr->second);
                 delete itr->second;
                 AuctionsMap.erase(itr++);
                 continue;
@@ -596,6 +665,7 @@ void AuctionHouseObject::Update()
                     sAuctionMgr.SendAuctionExpiredMail(itr->second);
 
                     itr->second->DeleteFromDB();
+                    RemoveAuctionFromIndex(itr->second);
                     delete itr->second;
                     AuctionsMap.erase(itr++);
                     continue;
@@ -704,16 +774,7 @@ int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry *auc, Pl
 
             int32 loc_idx = viewPlayer->GetSession()->GetSessionDbLocaleIndex();
 
-            std::string name1 = itemProto1->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto1->ItemId, loc_idx, &name1);
-
-            std::string name2 = itemProto2->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto2->ItemId, loc_idx, &name2);
-
-            std::wstring wname1, wname2;
-            Utf8toWStr(name1, wname1);
-            Utf8toWStr(name2, wname2);
-            return wname1.compare(wname2);
+            return sAuctionMgr.GetItemSearchName(itemProto1, loc_idx).compare(sAuctionMgr.GetItemSearchName(itemProto2, loc_idx));
         }
         case 6:                                             // minbidbuyout = 6
         {
@@ -793,11 +854,19 @@ bool AuctionSorter::operator()(const AuctionEntry *auc1, const AuctionEntry *auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
+void WorldSession::BuildListAuctionItems(AuctionHouseObject const* auctionHouse, AuctionSorter const& sorter, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
     uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull)
 {
     int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
 
+    std::vector<AuctionEntry*> auctions;
+    if (isFull)
+        auctionHouse->GetAuctionsByCategory(0xffffffff, 0xffffffff, 0xffffffff, auctions);
+    else
+        auctionHouse->GetAuctionsByCategory(itemClass, itemSubClass, inventoryType, auctions);
+
+    // filter before sort, only matching auctions are sorted
+    std::vector<AuctionEntry*>::iterator last = auctions.begin();
     for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
     {
         AuctionEntry *Aentry = *itr;
@@ -807,12 +876,7 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
         if (!item)
             continue;
 
-        if (isFull)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        else
+        if (!isFull)
         {
             ItemPrototype const *proto = item->GetProto();
 
@@ -834,21 +898,49 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
             if (usable != 0x00 && _player->CanUseItem(item) != EQUIP_ERR_OK)
                 continue;
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
+            if (!wsearchedname.empty() && sAuctionMgr.GetItemSearchName(proto, loc_idx).find(wsearchedname) == std::wstring::npos)
                 continue;
-
-            if (count < 50 && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
         }
 
-        ++totalcount;
+        *last++ = Aentry;
     }
+
+    auctions.erase(last, auctions.end());
+    totalcount = auctions.size();
+
+    // full list send all auctions, otherwise only one page of 50 auctions starting from listfrom
+    size_t listEnd = isFull ? auctions.size() : std::min(auctions.size(), size_t(listfrom) + 50);
+    if (listEnd < auctions.size())
+        std::partial_sort(auctions.begin(), auctions.begin() + listEnd, auctions.end(), sorter);
+    else
+        std::sort(auctions.begin(), auctions.end(), sorter);
+
+    for (size_t i = isFull ? 0 : listfrom; i < listEnd; ++i)
+    {
+        ++count;
+        auctions[i]->BuildAuctionInfo(data);
+    }
+}
+
+std::wstring const& AuctionHouseMgr::GetItemSearchName(ItemPrototype const* proto, int loc_idx)
+{
+    ItemSearchNames& names = mItemSearchNames[proto->ItemId];
+
+    size_t idx = loc_idx >= 0 ? size_t(loc_idx) + 1 : 0;
+    if (names.size() <= idx)
+        names.resize(idx + 1);
+
+    std::wstring& wname = names[idx];
+    if (wname.empty())
+    {
+        std::string name = proto->Name1;
+        sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+
+        Utf8toWStr(name, wname);
+        wstrToLower(wname);
+    }
+
+    return wname;
 }
 
 void AuctionHouseObject::BuildListPendingSales(WorldPacket& data, Player* player, uint32& count)
@@ -907,6 +999,8 @@ AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHou
 
     sAuctionMgr.AddAItem(newItem);
 
+    // not keyed by serial id: auction row must keep order with other bids and player inventory with own
+    // character saves, one key can't order both, so transaction wait all earlier async requests
     CharacterDatabase.BeginTransaction();
     newItem->SaveToDB();
     AH->SaveToDB();
@@ -984,6 +1078,7 @@ void AuctionEntry::AuctionBidWinning(Player* newbidder)
 {
     moneyDeliveryTime = time(NULL) + HOUR;
 
+    // not keyed, see AuctionHouseObject::AddAuction
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("UPDATE auction SET itemguid = 0, moneyTime = '" UI64FMTD "', buyguid = '%u', lastbid = '%u' WHERE id = '%u'", (uint64)moneyDeliveryTime, bidder, bid, Id);
     if (newbidder)
@@ -1024,6 +1119,7 @@ bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=NULL*/)
             auction_owner->GetSession()->SendAuctionOwnerNotification(this);
 
         // after this update we should save player's money ...
+        // not keyed, see AuctionHouseObject::AddAuction
         CharacterDatabase.BeginTransaction();
         CharacterDatabase.PExecute("UPDATE auction SET buyguid = '%u', lastbid = '%u' WHERE id = '%u'", bidder, bid, Id);
         if (newbidder)
@@ -26,6 +26,7 @@
 
 class Item;
 class Player;
+struct ItemPrototype;
 class Unit;
 class WorldPacket;
 
@@ -107,11 +108,7 @@ class AuctionHouseObject
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry *ah)
-        {
-            MANGOS_ASSERT( ah );
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry *ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -119,10 +116,10 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : NULL;
         }
 
-        bool RemoveAuction(uint32 id)
-        {
-            return AuctionsMap.erase(id);
-        }
+        bool RemoveAuction(uint32 id);
+
+        // select auctions by item class/subclass/inventory type (0xffffffff for any), other search filters must be checked by caller
+        void GetAuctionsByCategory(uint32 itemClass, uint32 itemSubClass, uint32 inventoryType, std::vector<AuctionEntry*>& auctions) const;
 
         void Update();
 
@@ -132,7 +129,20 @@ class AuctionHouseObject
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player * pl = NULL);
     private:
+        // category index key: item class, subclass and inventory type in high part, auction id in low part
+        typedef std::map<uint64, AuctionEntry*> AuctionCategoryIndex;
+
+        static uint64 GetCategoryKey(uint32 itemClass, uint32 itemSubClass, uint32 inventoryType, uint32 auctionId = 0)
+        {
+            return (uint64(itemClass & 0xFF) << 56) | (uint64(itemSubClass & 0xFF) << 48) | (uint64(inventoryType & 0xFF) << 40) | auctionId;
+        }
+
+        static uint64 GetCategoryKey(AuctionEntry const* auction);
+
+        void RemoveAuctionFromIndex(AuctionEntry const* auction) { CategoryIndex.erase(GetCategoryKey(auction)); }
+
         AuctionEntryMap AuctionsMap;
+        AuctionCategoryIndex CategoryIndex;
 };
 
 class AuctionSorter
@@ -186,6 +196,10 @@ class AuctionHouseMgr
         static uint32 GetAuctionHouseTeam(AuctionHouseEntry const* house);
         static AuctionHouseEntry const* GetAuctionHouseEntry(Unit* unit);
 
+        // lower case localized item name used for auction search and name sorting
+        std::wstring const& GetItemSearchName(ItemPrototype const* proto, int loc_idx);
+        void ClearItemSearchNames() { mItemSearchNames.clear(); }
+
     public:
         //load first auction items, because of check if item exists, when loading
         void LoadAuctionItems();
@@ -200,6 +214,12 @@ class AuctionHouseMgr
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        // lower case item names, index is locale index + 1 (0 for default locale)
+        typedef std::vector<std::wstring> ItemSearchNames;
+        typedef UNORDERED_MAP<uint32, ItemSearchNames> ItemSearchNamesMap;
+
+        ItemSearchNamesMap  mItemSearchNames;
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
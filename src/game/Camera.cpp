@@ -22,8 +22,9 @@
 #include "Log.h"
 #include "Errors.h"
 #include "Player.h"
+#include "World.h"
 
-Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl)
+Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl), m_visibilityX(0.0f), m_visibilityY(0.0f), m_visibilityMoved(-1.0f)
 {
     m_source->GetViewPoint().Attach(this);
 }
@@ -111,6 +112,8 @@ void Camera::Event_AddedToWorld()
 
 void Camera::Event_RemovedFromWorld()
 {
+    m_visibilityMoved = -1.0f;
+
     if (m_source == &m_owner)
     {
         m_gridRef.unlink();
@@ -148,6 +151,80 @@ void Camera::UpdateVisibilityForOwner()
     MaNGOS::VisibleNotifier notifier(*this);
     Cell::VisitAllObjects(m_source, notifier, m_source->GetMap()->GetVisibilityDistance(), false);
     notifier.Notify();
+
+    m_visibilityX = m_source->GetPositionX();
+    m_visibilityY = m_source->GetPositionY();
+    m_visibilityMoved = 0.0f;
+}
+
+void Camera::UpdateVisibilityForOwnerAfterMove()
+{
+    float x = m_source->GetPositionX();
+    float y = m_source->GetPositionY();
+    float dx = x - m_visibilityX;
+    float dy = y - m_visibilityY;
+    float moved = m_visibilityMoved + sqrt(dx*dx + dy*dy);
+
+    // in flight and at transport other distance rules are used, big moves are cheaper to do in full
+    if (m_visibilityMoved < 0.0f || moved > World::GetVisibilityIncrementalUpdateDistance() ||
+        m_owner.IsTaxiFlying() || m_owner.GetTransport())
+    {
+        UpdateVisibilityForOwner();
+        return;
+    }
+
+    Map& map = *m_source->GetMap();
+    float radius = std::min(map.GetVisibilityDistance() + m_source->GetObjectBoundingRadius(), 333.0f);
+
+    MaNGOS::VisibilityDeltaCheck check(m_visibilityX, m_visibilityY, x, y, map.GetVisibilityDistance());
+    MaNGOS::VisibleDeltaNotifier notifier(*this, check);
+    TypeContainerVisitor<MaNGOS::VisibleDeltaNotifier, GridTypeMapContainer > gnotifier(notifier);
+    TypeContainerVisitor<MaNGOS::VisibleDeltaNotifier, WorldTypeMapContainer > wnotifier(notifier);
+
+    CellArea oldArea = Cell::CalculateCellArea(m_visibilityX, m_visibilityY, radius);
+    CellArea newArea = Cell::CalculateCellArea(x, y, radius);
+
+    uint32 x_begin = std::min(oldArea.low_bound.x_coord, newArea.low_bound.x_coord);
+    uint32 x_end = std::max(oldArea.high_bound.x_coord, newArea.high_bound.x_coord);
+    uint32 y_begin = std::min(oldArea.low_bound.y_coord, newArea.low_bound.y_coord);
+    uint32 y_end = std::max(oldArea.high_bound.y_coord, newArea.high_bound.y_coord);
+
+    for (uint32 cell_x = x_begin; cell_x <= x_end; ++cell_x)
+    {
+        for (uint32 cell_y = y_begin; cell_y <= y_end; ++cell_y)
+        {
+            CellPair cellPair(cell_x, cell_y);
+            bool inOld = oldArea.IsInArea(cellPair);
+            bool inNew = newArea.IsInArea(cellPair);
+
+            if (inOld && inNew)
+            {
+                if (!check.IsCrossed(cellPair))
+                    continue;
+
+                notifier.i_checkAll = false;
+            }
+            // entered and left cell strips
+            else if (inOld || inNew)
+                notifier.i_checkAll = true;
+            else
+                continue;
+
+            Cell cell(cellPair);
+            // only visible from new position cells must be loaded as at full update
+            if (!inNew)
+                cell.SetNoCreate();
+
+            map.Visit(cell, gnotifier);
+            map.Visit(cell, wnotifier);
+        }
+    }
+
+    notifier.Notify();
+
+    m_visibilityX = x;
+    m_visibilityY = y;
+    m_visibilityMoved = moved;
 }
 
 //////////////////
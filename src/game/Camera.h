@@ -57,6 +57,10 @@ class MANGOS_DLL_SPEC Camera
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner();
 
+        // same after small viewpoint move: checks only cells entered/left and objects crossing visibility distance,
+        // falls back to full update after Visibility.IncrementalUpdateDistance total movement
+        void UpdateVisibilityForOwnerAfterMove();
+
     private:
         // called when viewpoint changes visibility state
         void Event_AddedToWorld();
@@ -67,6 +71,11 @@ class MANGOS_DLL_SPEC Camera
         Player& m_owner;
         WorldObject* m_source;
 
+        // viewpoint position at last visibility update and movement since last full update (<0 - full update required)
+        float m_visibilityX;
+        float m_visibilityY;
+        float m_visibilityMoved;
+
         void UpdateForCurrentViewPoint();
 
     public:
@@ -136,6 +145,11 @@ public:
     {
         CameraCall(&Camera::UpdateVisibilityForOwner);
     }
+
+    void Call_UpdateVisibilityForOwnerAfterMove()
+    {
+        CameraCall(&Camera::UpdateVisibilityForOwnerAfterMove);
+    }
 };
 
 #endif
@@ -34,6 +34,12 @@ struct MANGOS_DLL_DECL CellArea
 
     bool operator!() const { return low_bound == high_bound; }
 
+    bool IsInArea(CellPair const& p) const
+    {
+        return p.x_coord >= low_bound.x_coord && p.x_coord <= high_bound.x_coord &&
+            p.y_coord >= low_bound.y_coord && p.y_coord <= high_bound.y_coord;
+    }
+
     void ResizeBorders(CellPair& begin_cell, CellPair& end_cell) const
     {
         begin_cell = low_bound;
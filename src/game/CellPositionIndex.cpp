@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "CellPositionIndex.h"
+#include "Unit.h"
+
+#if defined(__AVX__)
+#  include <immintrin.h>
+#  define CELL_POSITION_INDEX_AVX
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  include <xmmintrin.h>
+#  define CELL_POSITION_INDEX_SSE
+#endif
+
+// compare squared distances with small reserve for float rounding, exact checks done by caller
+#define CELL_POSITION_INDEX_RESERVE 0.05f
+
+CellPositionIndex::~CellPositionIndex()
+{
+    for (CellPositionUnitList::const_iterator itr = m_units.begin(); itr != m_units.end(); ++itr)
+        (*itr)->m_cellPositionIndex = NULL;
+}
+
+void CellPositionIndex::Insert(Unit* unit, uint8 objectMask)
+{
+    MANGOS_ASSERT(!unit->m_cellPositionIndex);
+
+    unit->m_cellPositionIndex = this;
+    unit->m_cellPositionSlot = m_units.size();
+
+    m_x.push_back(unit->GetPositionX());
+    m_y.push_back(unit->GetPositionY());
+    m_boundingRadius.push_back(unit->GetObjectBoundingRadius());
+    m_objectMask.push_back(objectMask);
+    m_units.push_back(unit);
+}
+
+void CellPositionIndex::Remove(WorldObject* obj)
+{
+    if (CellPositionIndex* index = obj->m_cellPositionIndex)
+    {
+        index->Erase(obj->m_cellPositionSlot);
+        obj->m_cellPositionIndex = NULL;
+    }
+}
+
+void CellPositionIndex::Update(WorldObject* obj)
+{
+    if (CellPositionIndex* index = obj->m_cellPositionIndex)
+    {
+        uint32 slot = obj->m_cellPositionSlot;
+        index->m_x[slot] = obj->GetPositionX();
+        index->m_y[slot] = obj->GetPositionY();
+        index->m_boundingRadius[slot] = obj->GetObjectBoundingRadius();
+    }
+}
+
+void CellPositionIndex::Erase(uint32 slot)
+{
+    // move last element into freed slot
+    uint32 last = m_units.size() - 1;
+    if (slot != last)
+    {
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_boundingRadius[slot] = m_boundingRadius[last];
+        m_objectMask[slot] = m_objectMask[last];
+        m_units[slot] = m_units[last];
+        m_units[slot]->m_cellPositionSlot = slot;
+    }
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_boundingRadius.pop_back();
+    m_objectMask.pop_back();
+    m_units.pop_back();
+}
+
+void CellPositionIndex::SelectInCircle(float x, float y, float radius, uint8 objectMask, CellPositionUnitList& units) const
+{
+    uint32 size = m_units.size();
+    uint32 i = 0;
+
+    radius += CELL_POSITION_INDEX_RESERVE;
+
+#ifdef CELL_POSITION_INDEX_AVX
+    __m256 x8 = _mm256_set1_ps(x);
+    __m256 y8 = _mm256_set1_ps(y);
+    __m256 radius8 = _mm256_set1_ps(radius);
+
+    for (; i + 8 <= size; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&m_x[i]), x8);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&m_y[i]), y8);
+        __m256 dist = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 range = _mm256_add_ps(_mm256_loadu_ps(&m_boundingRadius[i]), radius8);
+
+        if (int hits = _mm256_movemask_ps(_mm256_cmp_ps(dist, _mm256_mul_ps(range, range), _CMP_LE_OQ)))
+            for (uint32 j = 0; j < 8; ++j)
+                if ((hits & (1 << j)) && (m_objectMask[i + j] & objectMask))
+                    units.push_back(m_units[i + j]);
+    }
+#endif
+
+#ifdef CELL_POSITION_INDEX_SSE
+    __m128 x4 = _mm_set1_ps(x);
+    __m128 y4 = _mm_set1_ps(y);
+    __m128 radius4 = _mm_set1_ps(radius);
+
+    for (; i + 4 <= size; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&m_x[i]), x4);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&m_y[i]), y4);
+        __m128 dist = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 range = _mm_add_ps(_mm_loadu_ps(&m_boundingRadius[i]), radius4);
+
+        if (int hits = _mm_movemask_ps(_mm_cmple_ps(dist, _mm_mul_ps(range, range))))
+            for (uint32 j = 0; j < 4; ++j)
+                if ((hits & (1 << j)) && (m_objectMask[i + j] & objectMask))
+                    units.push_back(m_units[i + j]);
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        float dx = m_x[i] - x;
+        float dy = m_y[i] - y;
+        float range = m_boundingRadius[i] + radius;
+
+        if (dx * dx + dy * dy <= range * range && (m_objectMask[i] & objectMask))
+            units.push_back(m_units[i]);
+    }
+}
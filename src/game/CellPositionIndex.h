@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CELLPOSITIONINDEX_H
+#define MANGOS_CELLPOSITIONINDEX_H
+
+#include "Common.h"
+#include <vector>
+
+class WorldObject;
+class Unit;
+
+// selects cell container of indexed objects, same as Cell::VisitGridObjects/VisitWorldObjects/VisitAllObjects
+enum CellPositionObjectMask
+{
+    CELL_POSITION_GRID_OBJECT   = 0x01,                     // creatures (not pets)
+    CELL_POSITION_WORLD_OBJECT  = 0x02,                     // players and pets
+    CELL_POSITION_ALL_OBJECTS   = CELL_POSITION_GRID_OBJECT | CELL_POSITION_WORLD_OBJECT
+};
+
+typedef std::vector<Unit*> CellPositionUnitList;
+
+/**
+ * Structure-of-arrays mirror of 2d positions and bounding radius of units in one grid cell.
+ * Kept in sync by Map at add/remove to/from cell grid and by WorldObject::Relocate,
+ * allow filter range candidates in packed float arrays (SSE/AVX where compiled in) without touching units.
+ */
+class CellPositionIndex
+{
+    public:
+        CellPositionIndex() {}
+        ~CellPositionIndex();
+
+        void Insert(Unit* unit, uint8 objectMask);
+        static void Remove(WorldObject* obj);
+        static void Update(WorldObject* obj);             // position or bounding radius changed
+
+        // add units with objectMask which center is in radius + own bounding radius from (x,y)
+        void SelectInCircle(float x, float y, float radius, uint8 objectMask, CellPositionUnitList& units) const;
+
+        bool empty() const { return m_units.empty(); }
+
+    private:
+        CellPositionIndex(CellPositionIndex const&);
+        CellPositionIndex& operator=(CellPositionIndex const&);
+
+        void Erase(uint32 slot);
+
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_boundingRadius;
+        std::vector<uint8> m_objectMask;
+        std::vector<Unit*> m_units;
+};
+
+#endif
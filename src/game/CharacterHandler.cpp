@@ -64,45 +64,48 @@ bool LoginQueryHolder::Initialize()
 {
     SetSize(MAX_PLAYER_LOGIN_QUERY);
 
+    // executed as prepared statements, rows are received with binary numeric values
+    static SqlStatementID loginStmts[MAX_PLAYER_LOGIN_QUERY];
+
     bool res = true;
 
     // NOTE: all fields in `characters` must be read to prevent lost character data at next save in case wrong DB structure.
     // !!! NOTE: including unused `zone`,`online`
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADFROM,            "SELECT guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags,"
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADFROM, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADFROM], "SELECT guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags,"
         "position_x, position_y, position_z, map, orientation, taximask, cinematic, totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost,"
         "resettalents_time, trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, online, death_expire_time, taxi_path, dungeon_difficulty,"
         "arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, todayKills, yesterdayKills, chosenTitle, knownCurrencies, watchedFaction, drunk,"
-        "health, power1, power2, power3, power4, power5, power6, power7, specCount, activeSpec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars FROM characters WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADGROUP,           "SELECT groupId FROM group_member WHERE memberGuid ='%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADBOUNDINSTANCES,  "SELECT id, permanent, map, difficulty, resettime FROM character_instance LEFT JOIN instance ON instance = id WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADAURAS,           "SELECT caster_guid,item_guid,spell,stackcount,remaincharges,basepoints0,basepoints1,basepoints2,periodictime0,periodictime1,periodictime2,maxduration,remaintime,effIndexMask FROM character_aura WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSPELLS,          "SELECT spell,active,disabled FROM character_spell WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADQUESTSTATUS,     "SELECT quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4,itemcount5,itemcount6 FROM character_queststatus WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADDAILYQUESTSTATUS,"SELECT quest FROM character_queststatus_daily WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS,"SELECT quest FROM character_queststatus_weekly WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS,"SELECT quest FROM character_queststatus_monthly WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADREPUTATION,      "SELECT faction,standing,flags FROM character_reputation WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADINVENTORY,       "SELECT data,text,bag,slot,item,item_template FROM character_inventory JOIN item_instance ON character_inventory.item = item_instance.guid WHERE character_inventory.guid = '%u' ORDER BY bag,slot", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADITEMLOOT,        "SELECT guid,itemid,amount,suffix,property FROM item_loot WHERE owner_guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADACTIONS,         "SELECT spec,button,action,type FROM character_action WHERE guid = '%u' ORDER BY button", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSOCIALLIST,      "SELECT friend,flags,note FROM character_social WHERE guid = '%u' LIMIT 255", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADHOMEBIND,        "SELECT map,zone,position_x,position_y,position_z FROM character_homebind WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSPELLCOOLDOWNS,  "SELECT spell,item,time FROM character_spell_cooldown WHERE guid = '%u'", m_guid.GetCounter());
+        "health, power1, power2, power3, power4, power5, power6, power7, specCount, activeSpec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars FROM characters WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADGROUP, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADGROUP], "SELECT groupId FROM group_member WHERE memberGuid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADBOUNDINSTANCES, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADBOUNDINSTANCES], "SELECT id, permanent, map, difficulty, resettime FROM character_instance LEFT JOIN instance ON instance = id WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADAURAS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADAURAS], "SELECT caster_guid,item_guid,spell,stackcount,remaincharges,basepoints0,basepoints1,basepoints2,periodictime0,periodictime1,periodictime2,maxduration,remaintime,effIndexMask FROM character_aura WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADSPELLS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADSPELLS], "SELECT spell,active,disabled FROM character_spell WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADQUESTSTATUS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADQUESTSTATUS], "SELECT quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4,itemcount5,itemcount6 FROM character_queststatus WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADDAILYQUESTSTATUS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADDAILYQUESTSTATUS], "SELECT quest FROM character_queststatus_daily WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS], "SELECT quest FROM character_queststatus_weekly WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS], "SELECT quest FROM character_queststatus_monthly WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADREPUTATION, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADREPUTATION], "SELECT faction,standing,flags FROM character_reputation WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADINVENTORY, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADINVENTORY], "SELECT data,text,bag,slot,item,item_template FROM character_inventory JOIN item_instance ON character_inventory.item = item_instance.guid WHERE character_inventory.guid = ? ORDER BY bag,slot"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADITEMLOOT, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADITEMLOOT], "SELECT guid,itemid,amount,suffix,property FROM item_loot WHERE owner_guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADACTIONS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADACTIONS], "SELECT spec,button,action,type FROM character_action WHERE guid = ? ORDER BY button"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADSOCIALLIST, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADSOCIALLIST], "SELECT friend,flags,note FROM character_social WHERE guid = ? LIMIT 255"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADHOMEBIND, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADHOMEBIND], "SELECT map,zone,position_x,position_y,position_z FROM character_homebind WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADSPELLCOOLDOWNS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADSPELLCOOLDOWNS], "SELECT spell,item,time FROM character_spell_cooldown WHERE guid = ?"), m_guid.GetCounter());
     if(sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED))
-        res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADDECLINEDNAMES,   "SELECT genitive, dative, accusative, instrumental, prepositional FROM character_declinedname WHERE guid = '%u'", m_guid.GetCounter());
+        res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADDECLINEDNAMES, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADDECLINEDNAMES], "SELECT genitive, dative, accusative, instrumental, prepositional FROM character_declinedname WHERE guid = ?"), m_guid.GetCounter());
     // in other case still be dummy query
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADGUILD,           "SELECT guildid,rank FROM guild_member WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADARENAINFO,       "SELECT arenateamid, played_week, played_season, wons_season, personal_rating FROM arena_team_member WHERE guid='%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADACHIEVEMENTS,    "SELECT achievement, date FROM character_achievement WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADCRITERIAPROGRESS,"SELECT criteria, counter, date FROM character_achievement_progress WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADEQUIPMENTSETS,   "SELECT setguid, setindex, name, iconname, ignore_mask, item0, item1, item2, item3, item4, item5, item6, item7, item8, item9, item10, item11, item12, item13, item14, item15, item16, item17, item18 FROM character_equipmentsets WHERE guid = '%u' ORDER BY setindex", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADBGDATA,          "SELECT instance_id, team, join_x, join_y, join_z, join_o, join_map, taxi_start, taxi_end, mount_spell FROM character_battleground_data WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADACCOUNTDATA,     "SELECT type, time, data FROM character_account_data WHERE guid='%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADTALENTS,         "SELECT talent_id, current_rank, spec FROM character_talent WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSKILLS,          "SELECT skill, value, max FROM character_skills WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADGLYPHS,          "SELECT spec, slot, glyph FROM character_glyphs WHERE guid='%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILS,           "SELECT id,messageType,sender,receiver,subject,body,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,     "SELECT data, text, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADGUILD, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADGUILD], "SELECT guildid,rank FROM guild_member WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADARENAINFO, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADARENAINFO], "SELECT arenateamid, played_week, played_season, wons_season, personal_rating FROM arena_team_member WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADACHIEVEMENTS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADACHIEVEMENTS], "SELECT achievement, date FROM character_achievement WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADCRITERIAPROGRESS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADCRITERIAPROGRESS], "SELECT criteria, counter, date FROM character_achievement_progress WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADEQUIPMENTSETS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADEQUIPMENTSETS], "SELECT setguid, setindex, name, iconname, ignore_mask, item0, item1, item2, item3, item4, item5, item6, item7, item8, item9, item10, item11, item12, item13, item14, item15, item16, item17, item18 FROM character_equipmentsets WHERE guid = ? ORDER BY setindex"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADBGDATA, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADBGDATA], "SELECT instance_id, team, join_x, join_y, join_z, join_o, join_map, taxi_start, taxi_end, mount_spell FROM character_battleground_data WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADACCOUNTDATA, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADACCOUNTDATA], "SELECT type, time, data FROM character_account_data WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADTALENTS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADTALENTS], "SELECT talent_id, current_rank, spec FROM character_talent WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADSKILLS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADSKILLS], "SELECT skill, value, max FROM character_skills WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADGLYPHS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADGLYPHS], "SELECT spec, slot, glyph FROM character_glyphs WHERE guid = ?"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADMAILS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADMAILS], "SELECT id,messageType,sender,receiver,subject,body,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = ? ORDER BY id DESC"), m_guid.GetCounter());
+    res &= SetPStatement(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS, CharacterDatabase.CreateStatement(loginStmts[PLAYER_LOGIN_QUERY_LOADMAILEDITEMS], "SELECT data, text, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = ?"), m_guid.GetCounter());
 
     return res;
 }
@@ -193,7 +193,7 @@ void Creature::AddToWorld()
 {
     ///- Register the creature for guid lookup
     if (!IsInWorld() && GetObjectGuid().IsCreatureOrVehicle())
-        GetMap()->GetObjectsStore().insert<Creature>(GetObjectGuid(), (Creature*)this);
+        GetMap()->InsertObject<Creature>(GetObjectGuid(), this);
 
     Unit::AddToWorld();
 }
@@ -202,7 +202,7 @@ void Creature::RemoveFromWorld()
 {
     ///- Remove the creature from the accessor
     if (IsInWorld() && GetObjectGuid().IsCreatureOrVehicle())
-        GetMap()->GetObjectsStore().erase<Creature>(GetObjectGuid(), (Creature*)NULL);
+        GetMap()->EraseObject<Creature>(GetObjectGuid());
 
     Unit::RemoveFromWorld();
 }
@@ -1779,8 +1779,12 @@ void Creature::CallAssistance()
 
             {
                 MaNGOS::AnyAssistCreatureInRangeCheck u_check(this, getVictim(), radius);
-                MaNGOS::CreatureListSearcher<MaNGOS::AnyAssistCreatureInRangeCheck> searcher(assistList, u_check);
-                Cell::VisitGridObjects(this,searcher, radius);
+
+                CellPositionUnitList units;
+                GetMap()->SelectUnitsInRange(this, radius, CELL_POSITION_GRID_OBJECT, units);
+                for(CellPositionUnitList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+                    if ((*itr)->InSamePhase(this) && u_check((Creature*)*itr))
+                        assistList.push_back((Creature*)*itr);
             }
 
             if (!assistList.empty())
@@ -1798,8 +1802,12 @@ void Creature::CallForHelp(float fRadius)
         return;
 
     MaNGOS::CallOfHelpCreatureInRangeDo u_do(this, getVictim(), fRadius);
-    MaNGOS::CreatureWorker<MaNGOS::CallOfHelpCreatureInRangeDo> worker(this, u_do);
-    Cell::VisitGridObjects(this,worker, fRadius);
+
+    CellPositionUnitList units;
+    GetMap()->SelectUnitsInRange(this, fRadius, CELL_POSITION_GRID_OBJECT, units);
+    for(CellPositionUnitList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        if ((*itr)->InSamePhase(this))
+            u_do((Creature*)*itr);
 }
 
 bool Creature::CanAssistTo(const Unit* u, const Unit* enemy, bool checkfaction /*= true*/) const
@@ -2406,14 +2414,16 @@ void Creature::FillGuidsListFromThreatList( std::vector<ObjectGuid>& guids, uint
     if (!CanHaveThreatList())
         return;
 
-    ThreatList const& threats = getThreatManager().getThreatList();
+    ThreatList const& threats = getThreatManager().getUnorderedThreatList();
 
     maxamount = maxamount > 0 ? std::min(maxamount,uint32(threats.size())) : threats.size();
 
     guids.reserve(guids.size() + maxamount);
 
-    for (ThreatList::const_iterator itr = threats.begin(); maxamount && itr != threats.end(); ++itr, --maxamount)
-        guids.push_back((*itr)->getUnitGuid());
+    // top threat part only, without sorting full list
+    ThreatContainer::OrderedWalker walker(getThreatManager().getThreatContainer());
+    for (; maxamount; --maxamount)
+        guids.push_back(walker.next()->getUnitGuid());
 }
 
 struct AddCreatureToRemoveListInMapsWorker
@@ -69,7 +69,7 @@ void GameObject::AddToWorld()
 {
     ///- Register the gameobject for guid lookup
     if(!IsInWorld())
-        GetMap()->GetObjectsStore().insert<GameObject>(GetObjectGuid(), (GameObject*)this);
+        GetMap()->InsertObject<GameObject>(GetObjectGuid(), this);
 
     Object::AddToWorld();
 }
@@ -91,7 +91,7 @@ void GameObject::RemoveFromWorld()
             }
         }
 
-        GetMap()->GetObjectsStore().erase<GameObject>(GetObjectGuid(), (GameObject*)NULL);
+        GetMap()->EraseObject<GameObject>(GetObjectGuid());
     }
 
     Object::RemoveFromWorld();
@@ -70,66 +70,64 @@ bool GridMap::loadData(char *filename)
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
     // Not return error if file not found
-    FILE *in = fopen(filename, "rb");
-    if (!in)
+    // file is mapped read-only and shared, so its pages are in system page cache and shared with other mangosd processes
+    if (m_mapping.map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
         return true;
 
-    fread(&header, sizeof(header),1,in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+    // mapping stays valid after file closing, not keep descriptor for each loaded grid
+    m_mapping.close_handle();
+
+#ifdef MADV_WILLNEED
+    // let system start read all file pages in background, before first height request
+    m_mapping.advise(MADV_WILLNEED);
+#endif
+
+    GridMapFileHeader header;
+    if (readFileData(0, header) &&
+        header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
         header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)) &&
         IsAcceptableClientBuild(header.buildMagic))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadGridMapLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    if (m_area_map)
-        delete[] m_area_map;
-
-    if (m_V9)
-        delete[] m_V9;
-
-    if (m_V8)
-        delete[] m_V8;
-
-    if (m_liquid_type)
-        delete[] m_liquid_type;
+    for (std::vector<uint8*>::const_iterator itr = m_copiedData.begin(); itr != m_copiedData.end(); ++itr)
+        delete[] *itr;
 
-    if (m_liquid_map)
-        delete[] m_liquid_map;
+    m_copiedData.clear();
+    m_mapping.close();
 
     m_area_map = NULL;
     m_V9 = NULL;
@@ -139,61 +137,96 @@ void GridMap::unloadData()
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE *in, uint32 offset, uint32 /*size*/)
+uint8 const* GridMap::getFileData(uint32 offset, uint32 size) const
+{
+    if (uint64(offset) + size > uint64(m_mapping.size()))
+        return NULL;
+
+    return static_cast<uint8 const*>(m_mapping.addr()) + offset;
+}
+
+template<typename T>
+bool GridMap::readFileData(uint32 offset, T& data) const
+{
+    uint8 const* src = getFileData(offset, sizeof(T));
+    if (!src)
+        return false;
+
+    memcpy(&data, src, sizeof(T));
+    return true;
+}
+
+template<typename T>
+T const* GridMap::mapFileArray(uint32 offset, uint32 count)
+{
+    uint8 const* src = getFileData(offset, count * sizeof(T));
+    if (!src)
+        return NULL;
+
+    // aligned arrays are used directly from mapped file
+    if (reinterpret_cast<size_t>(src) % sizeof(T) == 0)
+        return reinterpret_cast<T const*>(src);
+
+    // files created by old extractor can have unaligned liquid data, it must be copied
+    uint8* copy = new uint8[count * sizeof(T)];
+    memcpy(copy, src, count * sizeof(T));
+    m_copiedData.push_back(copy);
+    return reinterpret_cast<T const*>(copy);
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    if (!readFileData(offset, header) || header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
 
+    offset += sizeof(header);
+
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16*16];
-        fread(m_area_map, sizeof(uint16), 16*16, in);
+        m_area_map = mapFileArray<uint16>(offset, 16*16);
+        if (!m_area_map)
+            return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE *in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    if (!readFileData(offset, header) || header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
 
+    offset += sizeof(header);
+
     m_gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            fread(m_uint16_V9, sizeof(uint16), 129*129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128*128, in);
+            m_uint16_V9 = mapFileArray<uint16>(offset, 129*129);
+            m_uint16_V8 = mapFileArray<uint16>(offset + sizeof(uint16)*129*129, 128*128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            fread(m_uint8_V9, sizeof(uint8), 129*129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128*128, in);
+            m_uint8_V9 = mapFileArray<uint8>(offset, 129*129);
+            m_uint8_V8 = mapFileArray<uint8>(offset + sizeof(uint8)*129*129, 128*128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            fread(m_V9, sizeof(float), 129*129, in);
-            fread(m_V8, sizeof(float), 128*128, in);
+            m_V9 = mapFileArray<float>(offset, 129*129);
+            m_V8 = mapFileArray<float>(offset + sizeof(float)*129*129, 128*128);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
+
+        if (!m_V9 || !m_V8)
+            return false;
     }
     else
         m_gridGetHeight = &GridMap::getHeightFromFlat;
@@ -201,14 +234,14 @@ bool GridMap::loadHeightData(FILE *in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadGridMapLiquidData(FILE *in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    if (!readFileData(offset, header) || header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
 
+    offset += sizeof(header);
+
     m_liquidType    = header.liquidType;
     m_liquid_offX   = header.offsetX;
     m_liquid_offY   = header.offsetY;
@@ -218,14 +251,18 @@ bool GridMap::loadGridMapLiquidData(FILE *in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquid_type = new uint8 [16*16];
-        fread(m_liquid_type, sizeof(uint8), 16*16, in);
+        m_liquid_type = mapFileArray<uint8>(offset, 16*16);
+        if (!m_liquid_type)
+            return false;
+
+        offset += sizeof(uint8)*16*16;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width*m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width*m_liquid_height, in);
+        m_liquid_map = mapFileArray<float>(offset, m_liquid_width*m_liquid_height);
+        if (!m_liquid_map)
+            return false;
     }
 
     return true;
@@ -346,7 +383,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -414,7 +451,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -625,6 +662,7 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
         {
             m_GridMaps[i][k] = NULL;
+            m_PreloadedGridMaps[i][k] = NULL;
             m_GridRef[i][k] = 0;
         }
     }
@@ -641,8 +679,13 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
 TerrainInfo::~TerrainInfo()
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
+    {
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
+        {
             delete m_GridMaps[i][k];
+            delete m_PreloadedGridMaps[i][k];
+        }
+    }
 
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
 }
@@ -663,6 +706,26 @@ GridMap * TerrainInfo::Load(const uint32 x, const uint32 y)
     return pMap;
 }
 
+void TerrainInfo::Preload(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    if(m_GridMaps[x][y] || m_PreloadedGridMaps[x][y])
+        return;
+
+    //file reading without lock, map thread can load other grids meanwhile
+    GridMap * map = LoadMap(x, y);
+
+    LOCK_GUARD lock(m_mutex);
+
+    //grid can be loaded by map thread already
+    if(!m_GridMaps[x][y] && !m_PreloadedGridMaps[x][y])
+        m_PreloadedGridMaps[x][y] = map;
+    else
+        delete map;
+}
+
 //schedule lazy GridMap object cleanup
 void TerrainInfo::Unload(const uint32 x, const uint32 y)
 {
@@ -1053,22 +1116,13 @@ GridMap * TerrainInfo::LoadMapAndVMap( const uint32 x, const uint32 y )
 
         if(!m_GridMaps[x][y])
         {
-            GridMap * map = new GridMap();
-
-            // map file name
-            char *tmp=NULL;
-            int len = sWorld.GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
-            tmp = new char[len];
-            snprintf(tmp, len, (char *)(sWorld.GetDataPath()+"maps/%03u%02u%02u.map").c_str(),m_mapId, x, y);
-            sLog.outDetail("Loading map %s",tmp);
-
-            if(!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: \n %s\n", tmp);
-                //ASSERT(false);
-            }
+            //take map data read by grid preloading if any
+            GridMap * map = m_PreloadedGridMaps[x][y];
+            if(map)
+                m_PreloadedGridMaps[x][y] = NULL;
+            else
+                map = LoadMap(x, y);
 
-            delete [] tmp;
             m_GridMaps[x][y] = map;
 
             //load VMAPs for current map/grid...
@@ -1094,6 +1148,27 @@ GridMap * TerrainInfo::LoadMapAndVMap( const uint32 x, const uint32 y )
     return  m_GridMaps[x][y];
 }
 
+GridMap * TerrainInfo::LoadMap( const uint32 x, const uint32 y ) const
+{
+    GridMap * map = new GridMap();
+
+    // map file name
+    char *tmp=NULL;
+    int len = sWorld.GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
+    tmp = new char[len];
+    snprintf(tmp, len, (char *)(sWorld.GetDataPath()+"maps/%03u%02u%02u.map").c_str(),m_mapId, x, y);
+    sLog.outDetail("Loading map %s",tmp);
+
+    if(!map->loadData(tmp))
+    {
+        sLog.outError("Error load map file: \n %s\n", tmp);
+        //ASSERT(false);
+    }
+
+    delete [] tmp;
+    return map;
+}
+
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= NULL*/) const
 {
     if (const_cast<TerrainInfo*>(this)->GetGrid(x, y))
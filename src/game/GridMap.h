@@ -26,6 +26,8 @@
 #include "Object.h"
 #include "SharedDefines.h"
 
+#include <ace/Mem_Map.h>
+
 #include <bitset>
 #include <list>
 
@@ -121,22 +123,22 @@ class GridMap
 
         // Area data
         uint16 m_gridArea;
-        uint16 *m_area_map;
+        uint16 const* m_area_map;
 
         // Height level data
         float m_gridHeight;
         float m_gridIntHeightMultiplier;
         union
         {
-            float *m_V9;
-            uint16 *m_uint16_V9;
-            uint8 *m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float *m_V8;
-            uint16 *m_uint16_V8;
-            uint8 *m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -146,12 +148,20 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint8 *m_liquid_type;
-        float *m_liquid_map;
+        uint8 const* m_liquid_type;
+        float const* m_liquid_map;
+
+        // Map file data, arrays above point into file mapping (or into copies of unaligned file data)
+        ACE_Mem_Map m_mapping;
+        std::vector<uint8*> m_copiedData;
 
-        bool loadAreaData(FILE *in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE *in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE *in, uint32 offset, uint32 size);
+        uint8 const* getFileData(uint32 offset, uint32 size) const;
+        template<typename T> bool readFileData(uint32 offset, T& data) const;
+        template<typename T> T const* mapFileArray(uint32 offset, uint32 count);
+
+        bool loadAreaData(uint32 offset, uint32 size);
+        bool loadHeightData(uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(uint32 offset, uint32 size);
 
         // Get height functions and pointers
         typedef float (GridMap::*pGetHeightPtr) (float x, float y) const;
@@ -241,6 +251,10 @@ public:
     //THIS METHOD IS NOT THREAD-SAFE!!!! AND IT SHOULDN'T BE THREAD-SAFE!!!!
     void CleanUpGrids(const uint32 diff);
 
+    //thread-safe, read .map file of grid in advance (vmaps are not thread-safe and loaded with grid)
+    //preloaded data is taken by first Load() of the grid
+    void Preload(const uint32 x, const uint32 y);
+
 protected:
     friend class Map;
     //load/unload terrain data
@@ -253,6 +267,7 @@ private:
 
     GridMap * GetGrid( const float x, const float y );
     GridMap * LoadMapAndVMap(const uint32 x, const uint32 y );
+    GridMap * LoadMap(const uint32 x, const uint32 y ) const;
 
     int RefGrid(const uint32& x, const uint32& y);
     int UnrefGrid(const uint32& x, const uint32& y);
@@ -260,6 +275,7 @@ private:
     const uint32 m_mapId;
 
     GridMap *m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+    GridMap *m_PreloadedGridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
     int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
     //global garbage collection timer
@@ -24,6 +24,7 @@
 #include "Map.h"
 #include "Transports.h"
 #include "ObjectAccessor.h"
+#include "World.h"
 #include "BattleGroundMgr.h"
 
 using namespace MaNGOS;
@@ -33,10 +34,99 @@ VisibleChangesNotifier::Visit(CameraMapType &m)
 {
     for(CameraMapType::iterator iter=m.begin(); iter != m.end(); ++iter)
     {
+        if (i_check)
+        {
+            // flight and transport passengers use other visibility distance rules
+            Player* owner = iter->getSource()->GetOwner();
+            WorldObject* body = iter->getSource()->GetBody();
+            if (!owner->IsTaxiFlying() && !owner->GetTransport() &&
+                !i_check->IsCrossed(body->GetPositionX(), body->GetPositionY(), body->GetObjectBoundingRadius() + i_object.GetObjectBoundingRadius()))
+                continue;
+        }
+
         iter->getSource()->UpdateVisibilityOf(&i_object);
     }
 }
 
+VisibilityDeltaCheck::VisibilityDeltaCheck(float oldX, float oldY, float newX, float newY, float visibleDist) :
+    i_oldX(oldX), i_oldY(oldY), i_newX(newX), i_newY(newY)
+{
+    // both sides of the move may be stale up to relocation lower limit
+    float margin = 2.0f * sqrt(World::GetRelocationLowerLimitSq());
+
+    i_innerDist = visibleDist - margin;
+    i_outerDist = visibleDist + std::max(World::GetVisibleUnitGreyDistance(), World::GetVisibleObjectGreyDistance()) + margin;
+}
+
+bool VisibilityDeltaCheck::IsCrossed(float x, float y, float boundingRadius) const
+{
+    float dxOld = x - i_oldX, dyOld = y - i_oldY;
+    float dxNew = x - i_newX, dyNew = y - i_newY;
+    float distOldSq = dxOld*dxOld + dyOld*dyOld;
+    float distNewSq = dxNew*dxNew + dyNew*dyNew;
+
+    if (i_innerDist > 0.0f && std::max(distOldSq, distNewSq) < i_innerDist*i_innerDist)
+        return false;
+
+    float outerDist = i_outerDist + boundingRadius;
+    return std::min(distOldSq, distNewSq) <= outerDist*outerDist;
+}
+
+bool VisibilityDeltaCheck::IsCrossed(CellPair const& cellPair) const
+{
+    if (i_innerDist <= 0.0f)
+        return true;
+
+    // cell borders, see MaNGOS::ComputeCellPair
+    float x1 = (float(cellPair.x_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float y1 = (float(cellPair.y_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float x2 = x1 + SIZE_OF_GRID_CELL;
+    float y2 = y1 + SIZE_OF_GRID_CELL;
+
+    // only cell completely inside inner distance at both positions can be skipped
+    float dx = std::max(fabs(x1 - i_oldX), fabs(x2 - i_oldX));
+    float dy = std::max(fabs(y1 - i_oldY), fabs(y2 - i_oldY));
+    if (dx*dx + dy*dy >= i_innerDist*i_innerDist)
+        return true;
+
+    dx = std::max(fabs(x1 - i_newX), fabs(x2 - i_newX));
+    dy = std::max(fabs(y1 - i_newY), fabs(y2 - i_newY));
+    return dx*dx + dy*dy >= i_innerDist*i_innerDist;
+}
+
+// send create/outofrange packet collected by visibility notifiers and data for new visible objects
+static void SendVisibilityChanges(Player& player, UpdateData& data, std::set<WorldObject*> const& visibleNow)
+{
+    if (data.HasData())
+    {
+        // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
+        WorldPacket packet;
+        data.BuildPacket(&packet);
+        player.GetSession()->SendPacket(&packet);
+
+        // send out of range to other players if need
+        ObjectGuidSet const& oor = data.GetOutOfRangeGUIDs();
+        for(ObjectGuidSet::const_iterator iter = oor.begin(); iter != oor.end(); ++iter)
+        {
+            if (!iter->IsPlayer())
+                continue;
+
+            if (Player* plr = ObjectAccessor::FindPlayer(*iter))
+                plr->UpdateVisibilityOf(plr->GetCamera().GetBody(), &player);
+        }
+    }
+
+    // Now do operations that required done at object visibility change to visible
+
+    // send data at target visibility change (adding to client)
+    for(std::set<WorldObject*>::const_iterator vItr = visibleNow.begin(); vItr != visibleNow.end(); ++vItr)
+    {
+        // target aura duration for caster show only if target exist at caster client
+        if ((*vItr) != &player && (*vItr)->isType(TYPEMASK_UNIT))
+            player.SendAurasForTarget((Unit*)(*vItr));
+    }
+}
+
 void
 VisibleNotifier::Notify()
 {
@@ -47,7 +137,7 @@ VisibleNotifier::Notify()
     {
         for(Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin();itr!=transport->GetPassengers().end();++itr)
         {
-            if (i_clientGUIDs.find((*itr)->GetObjectGuid()) != i_clientGUIDs.end())
+            if (i_clientGUIDs.count((*itr)->GetObjectGuid()))
             {
                 // ignore far sight case
                 (*itr)->UpdateVisibilityOf(*itr, &player);
@@ -59,42 +149,22 @@ VisibleNotifier::Notify()
 
     // generate outOfRange for not iterate objects
     i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for(ObjectGuidSet::iterator itr = i_clientGUIDs.begin();itr!=i_clientGUIDs.end();++itr)
+    for(ObjectGuidHashSet::const_iterator itr = i_clientGUIDs.begin();itr!=i_clientGUIDs.end();++itr)
     {
         player.m_clientGUIDs.erase(*itr);
+        player.GetSession()->RemoveMovementOf(*itr);
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
             itr->GetString().c_str(), player.GetGuidStr().c_str());
     }
 
-    if (i_data.HasData())
-    {
-        // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
-        WorldPacket packet;
-        i_data.BuildPacket(&packet);
-        player.GetSession()->SendPacket(&packet);
-
-        // send out of range to other players if need
-        ObjectGuidSet const& oor = i_data.GetOutOfRangeGUIDs();
-        for(ObjectGuidSet::const_iterator iter = oor.begin(); iter != oor.end(); ++iter)
-        {
-            if (!iter->IsPlayer())
-                continue;
-
-            if (Player* plr = ObjectAccessor::FindPlayer(*iter))
-                plr->UpdateVisibilityOf(plr->GetCamera().GetBody(), &player);
-        }
-    }
-
-    // Now do operations that required done at object visibility change to visible
+    SendVisibilityChanges(player, i_data, i_visibleNow);
+}
 
-    // send data at target visibility change (adding to client)
-    for(std::set<WorldObject*>::const_iterator vItr = i_visibleNow.begin(); vItr != i_visibleNow.end(); ++vItr)
-    {
-        // target aura duration for caster show only if target exist at caster client
-        if ((*vItr) != &player && (*vItr)->isType(TYPEMASK_UNIT))
-            player.SendAurasForTarget((Unit*)(*vItr));
-    }
+void
+VisibleDeltaNotifier::Notify()
+{
+    SendVisibilityChanges(*i_camera.GetOwner(), i_data, i_visibleNow);
 }
 
 void
@@ -129,6 +199,23 @@ void MessageDelivererExcept::Visit(CameraMapType &m)
     }
 }
 
+void MovementMessageDeliverer::Visit(CameraMapType &m)
+{
+    for(CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* owner = iter->getSource()->GetOwner();
+
+        if (!owner->InSamePhase(i_mover.GetPhaseMask()) || owner == i_skipped_receiver)
+            continue;
+
+        WorldObject const* body = iter->getSource()->GetBody();
+        float dx = body->GetPositionX() - i_mover.GetPositionX();
+        float dy = body->GetPositionY() - i_mover.GetPositionY();
+
+        if (WorldSession* session = owner->GetSession())
+            session->SendMovementPacket(i_message, i_mover.GetObjectGuid(), dx*dx + dy*dy > i_nearDistSq);
+    }
+}
 
 void
 ObjectMessageDeliverer::Visit(CameraMapType &m)
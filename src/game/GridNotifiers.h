@@ -21,6 +21,7 @@
 
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include "SharedPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -40,7 +41,7 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        ObjectGuidSet i_clientGUIDs;
+        ObjectGuidHashSet i_clientGUIDs;
         std::set<WorldObject*> i_visibleNow;
 
         explicit VisibleNotifier(Camera &c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
@@ -49,11 +50,45 @@ namespace MaNGOS
         void Notify(void);
     };
 
+    // Visibility distance band crossed by a move from old to new position.
+    // Anything nearer than visibility distance (minus drift margin) or farther than visibility + grey
+    // distance (plus margin) at both positions keeps its visibility state, so needn't be rechecked.
+    // Margin covers objects that moved less than Visibility.RelocationLowerLimit since own notify.
+    struct MANGOS_DLL_DECL VisibilityDeltaCheck
+    {
+        float i_oldX, i_oldY;
+        float i_newX, i_newY;
+        float i_innerDist;
+        float i_outerDist;
+
+        VisibilityDeltaCheck(float oldX, float oldY, float newX, float newY, float visibleDist);
+
+        bool IsCrossed(float x, float y, float boundingRadius) const;
+        bool IsCrossed(CellPair const& cellPair) const;
+    };
+
+    // VisibleNotifier version for small viewpoint moves: objects in cells entered or left since last update
+    // are checked always, objects in cells seen from both positions only if their distance crossed the band
+    struct MANGOS_DLL_DECL VisibleDeltaNotifier
+    {
+        Camera& i_camera;
+        VisibilityDeltaCheck const& i_check;
+        bool i_checkAll;
+        UpdateData i_data;
+        std::set<WorldObject*> i_visibleNow;
+
+        VisibleDeltaNotifier(Camera &c, VisibilityDeltaCheck const& check) : i_camera(c), i_check(check), i_checkAll(true) {}
+        template<class T> void Visit(GridRefManager<T> &m);
+        void Visit(CameraMapType &m) {}
+        void Notify(void);
+    };
+
     struct MANGOS_DLL_DECL VisibleChangesNotifier
     {
         WorldObject &i_object;
+        VisibilityDeltaCheck const* i_check;                // set at object move, skip cameras far from band
 
-        explicit VisibleChangesNotifier(WorldObject &object) : i_object(object) {}
+        explicit VisibleChangesNotifier(WorldObject &object, VisibilityDeltaCheck const* check = NULL) : i_object(object), i_check(check) {}
         template<class T> void Visit(GridRefManager<T> &) {}
         void Visit(CameraMapType &);
     };
@@ -61,9 +96,9 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL MessageDeliverer
     {
         Player &i_player;
-        WorldPacket *i_message;
+        SharedPacket i_message;
         bool i_toSelf;
-        MessageDeliverer(Player &pl, WorldPacket *msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
+        MessageDeliverer(Player &pl, WorldPacket *msg, bool to_self) : i_player(pl), i_message(*msg), i_toSelf(to_self) {}
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -71,11 +106,26 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket*  i_message;
+        SharedPacket  i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket *msg, Player const* skipped)
-            : i_phaseMask(obj->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped) {}
+            : i_phaseMask(obj->GetPhaseMask()), i_message(*msg), i_skipped_receiver(skipped) {}
+
+        void Visit(CameraMapType &m);
+        template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
+    };
+
+    // movement packet queued to receivers sessions for batched send, receivers far from mover get less heartbeats
+    struct MovementMessageDeliverer
+    {
+        WorldObject const& i_mover;
+        WorldPacket const& i_message;
+        Player const* i_skipped_receiver;
+        float i_nearDistSq;
+
+        MovementMessageDeliverer(WorldObject const& mover, WorldPacket const& msg, Player const* skipped, float nearDist)
+            : i_mover(mover), i_message(msg), i_skipped_receiver(skipped), i_nearDistSq(nearDist * nearDist) {}
 
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
@@ -84,9 +134,9 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket *i_message;
+        SharedPacket i_message;
         explicit ObjectMessageDeliverer(WorldObject& obj, WorldPacket *msg)
-            : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
+            : i_phaseMask(obj.GetPhaseMask()), i_message(*msg) {}
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -94,13 +144,13 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL MessageDistDeliverer
     {
         Player &i_player;
-        WorldPacket *i_message;
+        SharedPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
 
         MessageDistDeliverer(Player &pl, WorldPacket *msg, float dist, bool to_self, bool ownTeamOnly)
-            : i_player(pl), i_message(msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
+            : i_player(pl), i_message(*msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -108,9 +158,9 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDistDeliverer
     {
         WorldObject &i_object;
-        WorldPacket *i_message;
+        SharedPacket i_message;
         float i_dist;
-        ObjectMessageDistDeliverer(WorldObject &obj, WorldPacket *msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
+        ObjectMessageDistDeliverer(WorldObject &obj, WorldPacket *msg, float dist) : i_object(obj), i_message(*msg), i_dist(dist) {}
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -126,22 +176,16 @@ namespace MaNGOS
         void Visit(CreatureMapType &);
     };
 
-    struct MANGOS_DLL_DECL PlayerRelocationNotifier
+    // AI reactions to moves of all units queued for relocation notify in one cell,
+    // filled with movers which aggro area includes currently visited cell
+    struct MANGOS_DLL_DECL RelocationNotifier
     {
-        Player &i_player;
-        PlayerRelocationNotifier(Player &pl) : i_player(pl) {}
-        template<class T> void Visit(GridRefManager<T> &) {}
-        void Visit(CreatureMapType &);
-    };
+        std::vector<Player*> i_players;
+        std::vector<Creature*> i_creatures;
 
-    struct MANGOS_DLL_DECL CreatureRelocationNotifier
-    {
-        Creature &i_creature;
-        CreatureRelocationNotifier(Creature &c) : i_creature(c) {}
         template<class T> void Visit(GridRefManager<T> &) {}
-        #ifdef WIN32
-        template<> void Visit(PlayerMapType &);
-        #endif
+        void Visit(PlayerMapType &);
+        void Visit(CreatureMapType &);
     };
 
     struct MANGOS_DLL_DECL DynamicObjectUpdater
@@ -1231,9 +1275,6 @@ namespace MaNGOS
     };
 
     #ifndef WIN32
-    template<> void PlayerRelocationNotifier::Visit<Creature>(CreatureMapType &);
-    template<> void CreatureRelocationNotifier::Visit<Player>(PlayerMapType &);
-    template<> void CreatureRelocationNotifier::Visit<Creature>(CreatureMapType &);
     template<> inline void DynamicObjectUpdater::Visit<Creature>(CreatureMapType &);
     template<> inline void DynamicObjectUpdater::Visit<Player>(PlayerMapType &);
     #endif
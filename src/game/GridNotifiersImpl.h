@@ -38,6 +38,18 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T> &m)
     }
 }
 
+template<class T>
+inline void MaNGOS::VisibleDeltaNotifier::Visit(GridRefManager<T> &m)
+{
+    for(typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        T* target = iter->getSource();
+        if (i_checkAll || i_check.IsCrossed(target->GetPositionX(), target->GetPositionY(),
+            target->GetObjectBoundingRadius() + i_camera.GetBody()->GetObjectBoundingRadius()))
+            i_camera.UpdateVisibilityOf(target, i_data, i_visibleNow);
+    }
+}
+
 inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType &m)
 {
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -72,44 +84,36 @@ inline void CreatureCreatureRelocationWorker(Creature* c1, Creature* c2)
     }
 }
 
-inline void MaNGOS::PlayerRelocationNotifier::Visit(CreatureMapType &m)
+inline void MaNGOS::RelocationNotifier::Visit(PlayerMapType &m)
 {
-    if (!i_player.isAlive() || i_player.IsTaxiFlying())
-        return;
-
-    for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Creature* c = iter->getSource();
-        if (c->isAlive())
-            PlayerCreatureRelocationWorker(&i_player, c);
-    }
-}
-
-template<>
-inline void MaNGOS::CreatureRelocationNotifier::Visit(PlayerMapType &m)
-{
-    if (!i_creature.isAlive())
+    if (i_creatures.empty())
         return;
 
     for(PlayerMapType::iterator iter=m.begin(); iter != m.end(); ++iter)
     {
         Player* player = iter->getSource();
-        if (player->isAlive() && !player->IsTaxiFlying())
-            PlayerCreatureRelocationWorker(player, &i_creature);
+        if (!player->isAlive() || player->IsTaxiFlying())
+            continue;
+
+        for(std::vector<Creature*>::const_iterator itr = i_creatures.begin(); itr != i_creatures.end(); ++itr)
+            PlayerCreatureRelocationWorker(player, *itr);
     }
 }
 
-template<>
-inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType &m)
+inline void MaNGOS::RelocationNotifier::Visit(CreatureMapType &m)
 {
-    if (!i_creature.isAlive())
-        return;
-
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->getSource();
-        if (c != &i_creature && c->isAlive())
-            CreatureCreatureRelocationWorker(c, &i_creature);
+        if (!c->isAlive())
+            continue;
+
+        for(std::vector<Player*>::const_iterator itr = i_players.begin(); itr != i_players.end(); ++itr)
+            PlayerCreatureRelocationWorker(*itr, c);
+
+        for(std::vector<Creature*>::const_iterator itr = i_creatures.begin(); itr != i_creatures.end(); ++itr)
+            if (*itr != c)
+                CreatureCreatureRelocationWorker(c, *itr);
     }
 }
 
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "GridPreloader.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "ObjectGridLoader.h"
+#include "CellImpl.h"
+#include "Player.h"
+#include "World.h"
+#include "Log.h"
+
+#define GRID_PRELOAD_SAMPLE_INTERVAL    (1 * IN_MILLISECONDS)
+#define GRID_PRELOAD_MIN_SPEED          1.0f                // yards per second, standing players are loaded at enter as usual
+#define GRID_PRELOAD_MAX_SPEED          100.0f              // yards per second, faster moves are teleports and can't be predicted
+
+class GridPreloadRequest : public MapUpdater::Request
+{
+    public:
+        GridPreloadRequest(GridPreloader& preloader, TerrainInfo* terrain, uint32 gridId)
+            : m_preloader(preloader), m_terrain(terrain), m_gridId(gridId) {}
+
+        void call()
+        {
+            uint32 x = m_gridId / MAX_NUMBER_OF_GRIDS;
+            uint32 y = m_gridId % MAX_NUMBER_OF_GRIDS;
+
+            // terrain uses reversed grid coordinates
+            m_terrain->Preload((MAX_NUMBER_OF_GRIDS - 1) - x, (MAX_NUMBER_OF_GRIDS - 1) - y);
+            m_preloader.TerrainReady(m_gridId);
+        }
+
+    private:
+        GridPreloader& m_preloader;
+        TerrainInfo* m_terrain;
+        uint32 m_gridId;
+};
+
+GridPreloader::GridPreloader(Map& map) : m_map(map)
+{
+    m_sampleTimer.SetInterval(GRID_PRELOAD_SAMPLE_INTERVAL);
+}
+
+GridPreloader::~GridPreloader()
+{
+    Clear();
+}
+
+void GridPreloader::Clear()
+{
+    sMapMgr.GetGridPreloadUpdater().Wait(m_batch);
+
+    m_grids.clear();
+    m_commitQueue.clear();
+    m_samples.clear();
+    m_readyGrids.clear();
+}
+
+void GridPreloader::Update(uint32 diff)
+{
+    // instances are small and their grids are not unloaded while map exist
+    if (m_map.Instanceable() || !sMapMgr.GetGridPreloadUpdater().IsActive())
+        return;
+
+    m_sampleTimer.Update(diff);
+    if (m_sampleTimer.Passed())
+    {
+        PredictGrids(m_sampleTimer.GetCurrent());
+        m_sampleTimer.SetCurrent(0);
+    }
+
+    CommitGrids();
+}
+
+uint32 GridPreloader::ReleaseGrid(uint32 x, uint32 y)
+{
+    if (m_grids.empty())
+        return 0;
+
+    GridPreloadInfoMap::iterator itr = m_grids.find(x * MAX_NUMBER_OF_GRIDS + y);
+    if (itr == m_grids.end())
+        return 0;
+
+    // queued ids of released grids are skipped at commit
+    uint32 loadedCells = itr->second.loadedCells;
+    m_grids.erase(itr);
+    return loadedCells;
+}
+
+void GridPreloader::PredictGrids(uint32 elapsed)
+{
+    // velocity from move since previous sample, scaled to look ahead time
+    float lookAhead = float(sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD)) / elapsed;
+    float minMove = GRID_PRELOAD_MIN_SPEED * elapsed / IN_MILLISECONDS;
+    float maxMove = GRID_PRELOAD_MAX_SPEED * elapsed / IN_MILLISECONDS;
+
+    PositionSampleMap samples;
+
+    Map::PlayerList const& players = m_map.GetPlayers();
+    for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (!plr->IsInWorld() || !plr->IsPositionValid())
+            continue;
+
+        PositionSample& sample = samples[plr->GetObjectGuid()];
+        sample.x = plr->GetPositionX();
+        sample.y = plr->GetPositionY();
+
+        PositionSampleMap::const_iterator last = m_samples.find(plr->GetObjectGuid());
+        if (last == m_samples.end())
+            continue;
+
+        float dx = sample.x - last->second.x;
+        float dy = sample.y - last->second.y;
+        float move = sqrt(dx * dx + dy * dy);
+        if (move < minMove || move > maxMove)
+            continue;
+
+        float x = sample.x + dx * lookAhead;
+        float y = sample.y + dy * lookAhead;
+        MaNGOS::NormalizeMapCoord(x);
+        MaNGOS::NormalizeMapCoord(y);
+
+        ScheduleGridsAround(x, y);
+    }
+
+    // players left map are forgotten
+    m_samples.swap(samples);
+}
+
+void GridPreloader::ScheduleGridsAround(float x, float y)
+{
+    CellArea area = Cell::CalculateCellArea(x, y, m_map.GetVisibilityDistance());
+
+    for (uint32 grid_x = area.low_bound.x_coord / MAX_NUMBER_OF_CELLS; grid_x <= area.high_bound.x_coord / MAX_NUMBER_OF_CELLS; ++grid_x)
+    {
+        for (uint32 grid_y = area.low_bound.y_coord / MAX_NUMBER_OF_CELLS; grid_y <= area.high_bound.y_coord / MAX_NUMBER_OF_CELLS; ++grid_y)
+        {
+            if (m_map.loaded(GridPair(grid_x, grid_y)))
+                continue;
+
+            uint32 gridId = grid_x * MAX_NUMBER_OF_GRIDS + grid_y;
+            if (m_grids.find(gridId) != m_grids.end())
+                continue;
+
+            m_grids[gridId] = GridPreloadInfo();
+            sMapMgr.GetGridPreloadUpdater().Schedule(new GridPreloadRequest(*this, m_map.m_TerrainData, gridId), &m_batch);
+        }
+    }
+}
+
+void GridPreloader::TerrainReady(uint32 gridId)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_readyLock);
+    m_readyGrids.push_back(gridId);
+}
+
+void GridPreloader::CommitGrids()
+{
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_readyLock);
+
+        for (GridIdList::const_iterator itr = m_readyGrids.begin(); itr != m_readyGrids.end(); ++itr)
+        {
+            GridPreloadInfoMap::iterator info = m_grids.find(*itr);
+            if (info != m_grids.end() && info->second.state == GRID_PRELOAD_TERRAIN)
+            {
+                info->second.state = GRID_PRELOAD_OBJECTS;
+                m_commitQueue.push_back(*itr);
+            }
+        }
+
+        m_readyGrids.clear();
+    }
+
+    if (m_commitQueue.empty())
+        return;
+
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_COMMIT_TIME);
+    uint32 startTime = WorldTimer::getMSTime();
+
+    while (!m_commitQueue.empty())
+    {
+        uint32 gridId = m_commitQueue.front();
+
+        // released by usual grid load or unload meanwhile
+        GridPreloadInfoMap::iterator info = m_grids.find(gridId);
+        if (info == m_grids.end() || info->second.state != GRID_PRELOAD_OBJECTS)
+        {
+            m_commitQueue.pop_front();
+            continue;
+        }
+
+        uint32 x = gridId / MAX_NUMBER_OF_GRIDS;
+        uint32 y = gridId % MAX_NUMBER_OF_GRIDS;
+
+        // terrain .map data is taken from preloaded, vmap tile loaded here
+        m_map.EnsureGridCreated(GridPair(x, y));
+        NGridType* grid = m_map.getNGrid(x, y);
+
+        // counted before load: object load can trigger usual load of this grid, it must continue from next cell
+        uint32 cellIdx = info->second.loadedCells++;
+
+        Cell cell(CellPair(x * MAX_NUMBER_OF_CELLS, y * MAX_NUMBER_OF_CELLS));
+        ObjectGridLoader loader(*grid, &m_map, cell);
+        loader.LoadCells(cellIdx, cellIdx + 1);
+
+        info = m_grids.find(gridId);
+        if (info == m_grids.end())
+            m_commitQueue.pop_front();
+        else if (info->second.loadedCells == MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS)
+        {
+            m_map.setGridObjectDataLoaded(true, x, y);
+            m_map.ResetGridExpiry(*grid);
+            info->second.state = GRID_PRELOAD_DONE;
+            m_commitQueue.pop_front();
+
+            DEBUG_LOG("Grid[%u,%u] for map %u preloaded", x, y, m_map.GetId());
+        }
+
+        if (WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()) >= budget)
+            break;
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_GRIDPRELOADER_H
+#define MANGOS_GRIDPRELOADER_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "Timer.h"
+#include "MapUpdater.h"
+#include <ace/Thread_Mutex.h>
+
+class Map;
+
+/**
+ * Loads continent grids ahead of moving players, so entering them later doesn't stall the map update.
+ *
+ * Player positions are sampled every second, and grids seen from the point where the player will be
+ * after GridPreload.LookAhead ms at current velocity are requested from grid preload threads. These only
+ * read terrain .map files into TerrainInfo. When terrain is ready, the map thread creates the grid (vmap
+ * tile loaded here, vmaps are not thread-safe) and loads its creatures and gameobjects cell by cell,
+ * no longer than GridPreload.CommitTime ms per map update. Grid is marked loaded only after all cells,
+ * and its first enter is handled as a just loaded grid.
+ */
+class GridPreloader
+{
+    public:
+        explicit GridPreloader(Map& map);
+        ~GridPreloader();
+
+        // called from map update before update of active cells
+        void Update(uint32 diff);
+
+        // forget preload progress at usual grid load or unload
+        // return count of grid cells with objects already loaded by preloader
+        uint32 ReleaseGrid(uint32 x, uint32 y);
+
+        // wait requests in progress, must be called before map release own terrain
+        void Clear();
+
+    private:
+        friend class GridPreloadRequest;
+
+        enum GridPreloadState
+        {
+            GRID_PRELOAD_TERRAIN,                           // terrain requested from preload thread
+            GRID_PRELOAD_OBJECTS,                           // terrain ready, objects loaded by map update
+            GRID_PRELOAD_DONE                               // grid loaded, wait first enter
+        };
+
+        struct GridPreloadInfo
+        {
+            GridPreloadInfo() : state(GRID_PRELOAD_TERRAIN), loadedCells(0) {}
+
+            GridPreloadState state;
+            uint32 loadedCells;
+        };
+
+        struct PositionSample
+        {
+            float x;
+            float y;
+        };
+
+        typedef UNORDERED_MAP<uint32, GridPreloadInfo> GridPreloadInfoMap;
+        typedef UNORDERED_MAP<ObjectGuid, PositionSample> PositionSampleMap;
+        typedef std::vector<uint32> GridIdList;
+        typedef std::deque<uint32> GridIdQueue;
+
+        void PredictGrids(uint32 elapsed);
+        void ScheduleGridsAround(float x, float y);
+        void CommitGrids();
+
+        // called from preload thread
+        void TerrainReady(uint32 gridId);
+
+        Map& m_map;
+        GridPreloadInfoMap m_grids;
+        GridIdQueue m_commitQueue;                          // grids with ready terrain, in ready order
+        PositionSampleMap m_samples;                        // player positions at previous sample
+        ShortIntervalTimer m_sampleTimer;
+
+        ACE_Thread_Mutex m_readyLock;
+        GridIdList m_readyGrids;                            // filled by preload threads
+        MapUpdater::Batch m_batch;
+};
+
+#endif
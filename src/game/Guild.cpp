@@ -130,7 +130,7 @@ bool Guild::Create(Player* leader, std::string gname)
     CharacterDatabase.escape_string(dbGINFO);
     CharacterDatabase.escape_string(dbMOTD);
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(m_Id);
     // CharacterDatabase.PExecute("DELETE FROM guild WHERE guildid='%u'", Id); - MAX(guildid)+1 not exist
     CharacterDatabase.PExecute("DELETE FROM guild_member WHERE guildid='%u'", m_Id);
     CharacterDatabase.PExecute("INSERT INTO guild (guildid,name,leaderguid,info,motd,createdate,EmblemStyle,EmblemColor,BorderStyle,BorderColor,BackgroundColor,BankMoney) "
@@ -377,7 +377,7 @@ bool Guild::LoadRanksFromDB(QueryResult *guildRanksResult)
     if (broken_ranks)
     {
         sLog.outError("Guild %u has broken `guild_rank` data, repairing...", m_Id);
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(m_Id);
         CharacterDatabase.PExecute("DELETE FROM guild_rank WHERE guildid='%u'", m_Id);
         for(size_t i = 0; i < m_Ranks.size(); ++i)
         {
@@ -706,7 +706,7 @@ void Guild::Disband()
         DelMember(ObjectGuid(HIGHGUID_PLAYER, itr->first), true);
     }
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(m_Id);
     CharacterDatabase.PExecute("DELETE FROM guild WHERE guildid = '%u'", m_Id);
     CharacterDatabase.PExecute("DELETE FROM guild_rank WHERE guildid = '%u'", m_Id);
     CharacterDatabase.PExecute("DELETE FROM guild_bank_tab WHERE guildid = '%u'", m_Id);
@@ -1089,7 +1089,7 @@ void Guild::CreateNewBankTab()
     uint32 tabId = GetPurchasedTabs();                      // next free id
     m_TabListMap.push_back(new GuildBankTab);
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(m_Id);
     CharacterDatabase.PExecute("DELETE FROM guild_bank_tab WHERE guildid='%u' AND TabId='%u'", m_Id, tabId);
     CharacterDatabase.PExecute("INSERT INTO guild_bank_tab (guildid,TabId) VALUES ('%u','%u')", m_Id, tabId);
     CharacterDatabase.CommitTransaction();
@@ -1930,6 +1930,7 @@ void Guild::SendGuildBankTabText(WorldSession *session, uint8 TabId)
         BroadcastPacket(&data);
 }
 
+// guild only data changed, transactions keyed by guild id
 void Guild::SwapItems(Player * pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankTabDst, uint8 BankTabSlotDst, uint32 SplitedAmount )
 {
     // empty operation
@@ -1976,7 +1977,7 @@ void Guild::SwapItems(Player * pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankT
             return;
         }
 
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(m_Id);
         LogBankEvent(GUILD_BANK_LOG_MOVE_ITEM, BankTab, pl->GetGUIDLow(), pItemSrc->GetEntry(), SplitedAmount, BankTabDst);
 
         pl->ItemRemovedQuestCheck( pItemSrc->GetEntry(), SplitedAmount );
@@ -1992,7 +1993,7 @@ void Guild::SwapItems(Player * pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankT
         InventoryResult msg = CanStoreItem(BankTabDst,BankTabSlotDst,gDest,pItemSrc->GetCount(), pItemSrc, false);
         if (msg == EQUIP_ERR_OK)                            // merge to
         {
-            CharacterDatabase.BeginTransaction();
+            CharacterDatabase.BeginTransaction(m_Id);
             LogBankEvent(GUILD_BANK_LOG_MOVE_ITEM, BankTab, pl->GetGUIDLow(), pItemSrc->GetEntry(), pItemSrc->GetCount(), BankTabDst);
 
             RemoveItem(BankTab, BankTabSlot);
@@ -2029,7 +2030,7 @@ void Guild::SwapItems(Player * pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankT
                     return;
             }
 
-            CharacterDatabase.BeginTransaction();
+            CharacterDatabase.BeginTransaction(m_Id);
             LogBankEvent(GUILD_BANK_LOG_MOVE_ITEM, BankTab,    pl->GetGUIDLow(), pItemSrc->GetEntry(), pItemSrc->GetCount(), BankTabDst);
             LogBankEvent(GUILD_BANK_LOG_MOVE_ITEM, BankTabDst, pl->GetGUIDLow(), pItemDst->GetEntry(), pItemDst->GetCount(), BankTab);
 
@@ -2046,6 +2047,8 @@ void Guild::SwapItems(Player * pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankT
 }
 
 
+// bank and character inventory changed in one transaction: not keyed by guild id or by character guid,
+// because only one key order is kept between worker threads
 void Guild::MoveFromBankToChar( Player * pl, uint8 BankTab, uint8 BankTabSlot, uint8 PlayerBag, uint8 PlayerSlot, uint32 SplitedAmount)
 {
     Item *pItemBank = GetItem(BankTab, BankTabSlot);
@@ -2194,6 +2197,7 @@ void Guild::MoveFromBankToChar( Player * pl, uint8 BankTab, uint8 BankTabSlot, u
 }
 
 
+// not keyed transactions, see MoveFromBankToChar
 void Guild::MoveFromCharToBank( Player * pl, uint8 PlayerBag, uint8 PlayerSlot, uint8 BankTab, uint8 BankTabSlot, uint32 SplitedAmount )
 {
     Item *pItemBank = GetItem(BankTab, BankTabSlot);
@@ -54,6 +54,7 @@
 #include "InstanceData.h"
 #include "CreatureEventAIMgr.h"
 #include "DBCEnums.h"
+#include "CellPositionIndex.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
 
 static uint32 ahbotQualityIds[MAX_AUCTION_QUALITY] =
@@ -1058,6 +1059,7 @@ bool ChatHandler::HandleReloadLocalesItemCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Locales Item ... ");
     sObjectMgr.LoadItemLocales();
+    sAuctionMgr.ClearItemSearchNames();
     SendGlobalSysMessage("DB table `locales_item` reloaded.");
     return true;
 }
@@ -2671,11 +2673,9 @@ bool ChatHandler::HandleAddItemSetCommand(char* args)
     DETAIL_LOG(GetMangosString(LANG_ADDITEMSET), itemsetId);
 
     bool found = false;
-    for (uint32 id = 0; id < sItemStorage.MaxEntry; id++)
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        ItemPrototype const *pProto = sItemStorage.LookupEntry<ItemPrototype>(id);
-        if (!pProto)
-            continue;
+        ItemPrototype const* pProto = *itr;
 
         if (pProto->ItemSet == itemsetId)
         {
@@ -3114,20 +3114,18 @@ bool ChatHandler::HandleLookupItemCommand(char* args)
     uint32 counter = 0;
 
     // Search in `item_template`
-    for (uint32 id = 0; id < sItemStorage.MaxEntry; ++id)
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        ItemPrototype const *pProto = sItemStorage.LookupEntry<ItemPrototype >(id);
-        if(!pProto)
-            continue;
+        ItemPrototype const* pProto = *itr;
 
         int loc_idx = GetSessionDbLocaleIndex();
 
         std::string name;                                   // "" for let later only single time check default locale name directly
-        sObjectMgr.GetItemLocaleStrings(id, loc_idx, &name);
+        sObjectMgr.GetItemLocaleStrings(pProto->ItemId, loc_idx, &name);
         if ((name.empty() || !Utf8FitTo(name, wnamepart)) && !Utf8FitTo(pProto->Name1, wnamepart))
             continue;
 
-        ShowItemListHelper(id, loc_idx, pl);
+        ShowItemListHelper(pProto->ItemId, loc_idx, pl);
         ++counter;
     }
 
@@ -3472,16 +3470,14 @@ bool ChatHandler::HandleLookupCreatureCommand(char* args)
 
     uint32 counter = 0;
 
-    for (uint32 id = 0; id< sCreatureStorage.MaxEntry; ++id)
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo> (id);
-        if(!cInfo)
-            continue;
+        CreatureInfo const* cInfo = *itr;
 
         int loc_idx = GetSessionDbLocaleIndex();
 
         char const* name = "";                              // "" for avoid repeating check for default locale
-        sObjectMgr.GetCreatureLocaleStrings(id, loc_idx, &name);
+        sObjectMgr.GetCreatureLocaleStrings(cInfo->Entry, loc_idx, &name);
         if (!*name || !Utf8FitTo(name, wnamepart))
         {
             name = cInfo->Name;
@@ -3490,9 +3486,9 @@ bool ChatHandler::HandleLookupCreatureCommand(char* args)
         }
 
         if (m_session)
-            PSendSysMessage (LANG_CREATURE_ENTRY_LIST_CHAT, id, id, name);
+            PSendSysMessage (LANG_CREATURE_ENTRY_LIST_CHAT, cInfo->Entry, cInfo->Entry, name);
         else
-            PSendSysMessage (LANG_CREATURE_ENTRY_LIST_CONSOLE, id, name);
+            PSendSysMessage (LANG_CREATURE_ENTRY_LIST_CONSOLE, cInfo->Entry, name);
 
         ++counter;
     }
@@ -3519,16 +3515,14 @@ bool ChatHandler::HandleLookupObjectCommand(char* args)
 
     uint32 counter = 0;
 
-    for (uint32 id = 0; id< sGOStorage.MaxEntry; id++ )
+    for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
     {
-        GameObjectInfo const* gInfo = sGOStorage.LookupEntry<GameObjectInfo>(id);
-        if(!gInfo)
-            continue;
+        GameObjectInfo const* gInfo = *itr;
 
         int loc_idx = GetSessionDbLocaleIndex();
         if ( loc_idx >= 0 )
         {
-            GameObjectLocale const *gl = sObjectMgr.GetGameObjectLocale(id);
+            GameObjectLocale const *gl = sObjectMgr.GetGameObjectLocale(gInfo->id);
             if (gl)
             {
                 if ((int32)gl->Name.size() > loc_idx && !gl->Name[loc_idx].empty())
@@ -3538,9 +3532,9 @@ bool ChatHandler::HandleLookupObjectCommand(char* args)
                     if (Utf8FitTo(name, wnamepart))
                     {
                         if (m_session)
-                            PSendSysMessage(LANG_GO_ENTRY_LIST_CHAT, id, id, name.c_str());
+                            PSendSysMessage(LANG_GO_ENTRY_LIST_CHAT, gInfo->id, gInfo->id, name.c_str());
                         else
-                            PSendSysMessage(LANG_GO_ENTRY_LIST_CONSOLE, id, name.c_str());
+                            PSendSysMessage(LANG_GO_ENTRY_LIST_CONSOLE, gInfo->id, name.c_str());
                         ++counter;
                         continue;
                     }
@@ -3555,9 +3549,9 @@ bool ChatHandler::HandleLookupObjectCommand(char* args)
         if(Utf8FitTo(name, wnamepart))
         {
             if (m_session)
-                PSendSysMessage(LANG_GO_ENTRY_LIST_CHAT, id, id, name.c_str());
+                PSendSysMessage(LANG_GO_ENTRY_LIST_CHAT, gInfo->id, gInfo->id, name.c_str());
             else
-                PSendSysMessage(LANG_GO_ENTRY_LIST_CONSOLE, id, name.c_str());
+                PSendSysMessage(LANG_GO_ENTRY_LIST_CONSOLE, gInfo->id, name.c_str());
             ++counter;
         }
     }
@@ -4978,6 +4972,7 @@ static bool HandleResetStatsOrLevelHelper(Player* player)
         player->SetShapeshiftForm(FORM_NONE);
 
     player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_WORLD_OBJECT_SIZE );
+    CellPositionIndex::Update(player);
     player->SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f   );
 
     player->setFactionForRace(player->getRace());
@@ -5309,11 +5304,9 @@ bool ChatHandler::HandleQuestAddCommand(char* args)
     }
 
     // check item starting quest (it can work incorrectly if added without item in inventory)
-    for (uint32 id = 0; id < sItemStorage.MaxEntry; ++id)
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        ItemPrototype const *pProto = sItemStorage.LookupEntry<ItemPrototype>(id);
-        if (!pProto)
-            continue;
+        ItemPrototype const* pProto = *itr;
 
         if (pProto->StartQuest == entry)
         {
@@ -1118,17 +1118,14 @@ void LoadLootTemplates_Creature()
     LootTemplates_Creature.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        if(CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
+        if(uint32 lootid = itr->lootid)
         {
-            if(uint32 lootid = cInfo->lootid)
-            {
-                if (ids_set.find(lootid) == ids_set.end())
-                    LootTemplates_Creature.ReportNotExistedId(lootid);
-                else
-                    ids_setUsed.insert(lootid);
-            }
+            if (ids_set.find(lootid) == ids_set.end())
+                LootTemplates_Creature.ReportNotExistedId(lootid);
+            else
+                ids_setUsed.insert(lootid);
         }
     }
     for(LootIdSet::const_iterator itr = ids_setUsed.begin(); itr != ids_setUsed.end(); ++itr)
@@ -1148,17 +1145,14 @@ void LoadLootTemplates_Disenchant()
     LootTemplates_Disenchant.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sItemStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        if(ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(i))
+        if(uint32 lootid = itr->DisenchantID)
         {
-            if(uint32 lootid = proto->DisenchantID)
-            {
-                if (ids_set.find(lootid) == ids_set.end())
-                    LootTemplates_Disenchant.ReportNotExistedId(lootid);
-                else
-                    ids_setUsed.insert(lootid);
-            }
+            if (ids_set.find(lootid) == ids_set.end())
+                LootTemplates_Disenchant.ReportNotExistedId(lootid);
+            else
+                ids_setUsed.insert(lootid);
         }
     }
     for(LootIdSet::const_iterator itr = ids_setUsed.begin(); itr != ids_setUsed.end(); ++itr)
@@ -1193,17 +1187,14 @@ void LoadLootTemplates_Gameobject()
     LootTemplates_Gameobject.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sGOStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
     {
-        if(GameObjectInfo const* gInfo = sGOStorage.LookupEntry<GameObjectInfo>(i))
+        if(uint32 lootid = itr->GetLootId())
         {
-            if(uint32 lootid = gInfo->GetLootId())
-            {
-                if (ids_set.find(lootid) == ids_set.end())
-                    LootTemplates_Gameobject.ReportNotExistedId(lootid);
-                else
-                    ids_setUsed.insert(lootid);
-            }
+            if (ids_set.find(lootid) == ids_set.end())
+                LootTemplates_Gameobject.ReportNotExistedId(lootid);
+            else
+                ids_setUsed.insert(lootid);
         }
     }
     for(LootIdSet::const_iterator itr = ids_setUsed.begin(); itr != ids_setUsed.end(); ++itr)
@@ -1219,19 +1210,18 @@ void LoadLootTemplates_Item()
     LootTemplates_Item.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sItemStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        if(ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(i))
-        {
-            if  (!(proto->Flags & ITEM_FLAG_LOOTABLE))
-                continue;
+        ItemPrototype const* proto = *itr;
 
-            if (ids_set.find(proto->ItemId) != ids_set.end() || proto->MaxMoneyLoot > 0)
-                ids_set.erase(proto->ItemId);
-            // wdb have wrong data cases, so skip by default
-            else if (!sLog.HasLogFilter(LOG_FILTER_DB_STRICTED_CHECK))
-                LootTemplates_Item.ReportNotExistedId(proto->ItemId);
-        }
+        if  (!(proto->Flags & ITEM_FLAG_LOOTABLE))
+            continue;
+
+        if (ids_set.find(proto->ItemId) != ids_set.end() || proto->MaxMoneyLoot > 0)
+            ids_set.erase(proto->ItemId);
+        // wdb have wrong data cases, so skip by default
+        else if (!sLog.HasLogFilter(LOG_FILTER_DB_STRICTED_CHECK))
+            LootTemplates_Item.ReportNotExistedId(proto->ItemId);
     }
 
     // output error for any still listed (not referenced from appropriate table) ids
@@ -1244,11 +1234,9 @@ void LoadLootTemplates_Milling()
     LootTemplates_Milling.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sItemStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(i);
-        if(!proto)
-            continue;
+        ItemPrototype const* proto = *itr;
 
         if (!(proto->Flags & ITEM_FLAG_MILLABLE))
             continue;
@@ -1269,17 +1257,14 @@ void LoadLootTemplates_Pickpocketing()
     LootTemplates_Pickpocketing.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        if(CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
+        if(uint32 lootid = itr->pickpocketLootId)
         {
-            if(uint32 lootid = cInfo->pickpocketLootId)
-            {
-                if (ids_set.find(lootid) == ids_set.end())
-                    LootTemplates_Pickpocketing.ReportNotExistedId(lootid);
-                else
-                    ids_setUsed.insert(lootid);
-            }
+            if (ids_set.find(lootid) == ids_set.end())
+                LootTemplates_Pickpocketing.ReportNotExistedId(lootid);
+            else
+                ids_setUsed.insert(lootid);
         }
     }
     for(LootIdSet::const_iterator itr = ids_setUsed.begin(); itr != ids_setUsed.end(); ++itr)
@@ -1295,11 +1280,9 @@ void LoadLootTemplates_Prospecting()
     LootTemplates_Prospecting.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sItemStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<ItemPrototype> itr = sItemStorage.begin<ItemPrototype>(); itr != sItemStorage.end<ItemPrototype>(); ++itr)
     {
-        ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(i);
-        if (!proto)
-            continue;
+        ItemPrototype const* proto = *itr;
 
         if (!(proto->Flags & ITEM_FLAG_PROSPECTABLE))
             continue;
@@ -1335,17 +1318,14 @@ void LoadLootTemplates_Skinning()
     LootTemplates_Skinning.LoadAndCollectLootIds(ids_set);
 
     // remove real entries and check existence loot
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        if(CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
+        if(uint32 lootid = itr->SkinLootId)
         {
-            if(uint32 lootid = cInfo->SkinLootId)
-            {
-                if (ids_set.find(lootid) == ids_set.end())
-                    LootTemplates_Skinning.ReportNotExistedId(lootid);
-                else
-                    ids_setUsed.insert(lootid);
-            }
+            if (ids_set.find(lootid) == ids_set.end())
+                LootTemplates_Skinning.ReportNotExistedId(lootid);
+            else
+                ids_setUsed.insert(lootid);
         }
     }
     for(LootIdSet::const_iterator itr = ids_setUsed.begin(); itr != ids_setUsed.end(); ++itr)
@@ -39,6 +39,9 @@
 
 Map::~Map()
 {
+    // preload requests use map terrain
+    m_gridPreloader.Clear();
+
     UnloadAll(true);
 
     if(!m_scriptSchedule.empty())
@@ -60,7 +63,7 @@ Map::~Map()
 
 void Map::LoadMapAndVMap(int gx,int gy)
 {
-    if(m_bLoadedGrids[gx][gx])
+    if(m_bLoadedGrids[gx][gy])
         return;
 
     GridMap * pInfo = m_TerrainData->Load(gx, gy);
@@ -72,9 +75,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
   : i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
   m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
-  m_activeNonPlayersIter(m_activeNonPlayers.end()),
-  i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-  i_data(NULL), i_script_id(0)
+  i_gridExpiry(expiry), m_gridPreloader(*this), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+  m_cellRegionsUpdate(false), i_data(NULL), i_script_id(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -86,6 +88,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
             //z code
             m_bLoadedGrids[idx][j] = false;
             setNGrid(NULL, idx, j);
+            m_cellPositionIndexes[idx][j] = NULL;
         }
     }
 
@@ -116,6 +119,7 @@ template<>
 void Map::AddToGrid(Player* obj, NGridType *grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+    GetCellPositionIndex(cell).Insert(obj, CELL_POSITION_WORLD_OBJECT);
 }
 
 template<>
@@ -141,12 +145,14 @@ void Map::AddToGrid(Creature* obj, NGridType *grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).AddWorldObject<Creature>(obj);
         obj->SetCurrentCell(cell);
+        GetCellPositionIndex(cell).Insert(obj, CELL_POSITION_WORLD_OBJECT);
     }
     // add to grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<Creature>(obj);
         obj->SetCurrentCell(cell);
+        GetCellPositionIndex(cell).Insert(obj, CELL_POSITION_GRID_OBJECT);
     }
 }
 
@@ -160,6 +166,7 @@ template<>
 void Map::RemoveFromGrid(Player* obj, NGridType *grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject(obj);
+    CellPositionIndex::Remove(obj);
 }
 
 template<>
@@ -190,6 +197,8 @@ void Map::RemoveFromGrid(Creature* obj, NGridType *grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject<Creature>(obj);
     }
+
+    CellPositionIndex::Remove(obj);
 }
 
 void Map::DeleteFromWorld(Player* pl)
@@ -205,6 +214,7 @@ Map::EnsureGridCreated(const GridPair &p)
     {
         setNGrid(new NGridType(p.x_coord*MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
             p.x_coord, p.y_coord);
+        m_cellPositionIndexes[p.x_coord][p.y_coord] = new CellPositionIndex[MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS];
 
         // build a linkage between this map and NGridType
         buildNGridLinkage(getNGrid(p.x_coord, p.y_coord));
@@ -254,6 +264,10 @@ bool Map::EnsureGridLoaded(const Cell &cell)
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
     MANGOS_ASSERT(grid != NULL);
+
+    // cells loaded ahead of players by grid preloader, all cells for preloaded grid at first enter
+    uint32 preloadedCells = m_gridPreloader.ReleaseGrid(cell.GridX(), cell.GridY());
+
     if( !isGridObjectDataLoaded(cell.GridX(), cell.GridY()) )
     {
         //it's important to set it loaded before loading!
@@ -263,14 +277,14 @@ bool Map::EnsureGridLoaded(const Cell &cell)
         //summons some active object B, while B added to map grid loading called again and so on..
         setGridObjectDataLoaded(true,cell.GridX(), cell.GridY());
         ObjectGridLoader loader(*grid, this, cell);
-        loader.LoadN();
-
-        // Add resurrectable corpses to world object list in grid
-        sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(),cell.GridY()),(*grid)(cell.CellX(), cell.CellY()), this);
-        return true;
+        loader.LoadN(preloadedCells);
     }
+    else if (!preloadedCells)
+        return false;
 
-    return false;
+    // Add resurrectable corpses to world object list in grid
+    sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(),cell.GridY()),(*grid)(cell.CellX(), cell.CellY()), this);
+    return true;
 }
 
 void Map::LoadGrid(const Cell& cell, bool no_unload)
@@ -320,6 +334,14 @@ Map::Add(T *obj)
 
     obj->SetMap(this);
 
+    // grid creation and cell containers are shared with other regions, add after parallel cell update
+    if (m_cellRegionsUpdate)
+    {
+        SharedDataGuard guard(m_sharedDataLock);
+        m_delayedObjectChanges.push_back(DelayedObjectChange(&Map::ApplyDelayedAdd<T>, obj));
+        return;
+    }
+
     Cell cell(p);
     if(obj->isActiveObject())
         EnsureGridLoadedAtEnter(cell);
@@ -458,14 +480,14 @@ void Map::Update(const uint32 &t_diff)
         }
     }
 
+    /// load grids ahead of moving players
+    m_gridPreloader.Update(t_diff);
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
-    MaNGOS::ObjectUpdater updater(t_diff);
-    // for creature
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
-    // for pets
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+    // collect cells before update, so they can be split to independent regions
+    CellIdList cells;
 
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
@@ -477,70 +499,40 @@ void Map::Update(const uint32 &t_diff)
             continue;
 
         //lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
-
-        for(uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
-        {
-            for(uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-            {
-                // marked cells are those that have been visited
-                // don't visit the same cell twice
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if(!isCellMarked(cell_id))
-                {
-                    markCell(cell_id);
-                    CellPair pair(x,y);
-                    Cell cell(pair);
-                    cell.SetNoCreate();
-                    Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
-                }
-            }
-        }
+        MarkCellsAround(plr, cells);
     }
 
     // non-player active objects
-    if(!m_activeNonPlayers.empty())
+    for(ActiveNonPlayers::const_iterator itr = m_activeNonPlayers.begin(); itr != m_activeNonPlayers.end(); ++itr)
     {
-        for(m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end(); )
-        {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
+        WorldObject* obj = *itr;
 
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
+        // skip not in world
+        if (!obj->IsInWorld() || !obj->IsPositionValid())
+            continue;
 
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
-                continue;
+        MarkCellsAround(obj, cells);
+    }
 
-            //lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+    if (sMapMgr.GetCellRegionUpdater().IsActive())
+        UpdateCellRegions(cells, t_diff);
+    else
+        UpdateCells(cells, t_diff);
 
-            for(uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
-            {
-                for(uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-                {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if(!isCellMarked(cell_id))
-                    {
-                        markCell(cell_id);
-                        CellPair pair(x,y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
-                    }
-                }
-            }
-        }
-    }
+    // AI reactions to moves done in this and previous updates
+    ProcessRelocationNotifies();
 
     // Send world objects and item update field changes
     SendObjectUpdates();
 
+    // Send movement of other players collected in this update (also after aggregation disabled at reload)
+    for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* plr = m_mapRefIter->getSource();
+        if (plr && plr->IsInWorld())
+            plr->GetSession()->SendMovementBatch(t_diff);
+    }
+
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
@@ -563,6 +555,325 @@ void Map::Update(const uint32 &t_diff)
         i_data->Update(t_diff);
 }
 
+void Map::MarkCellsAround(WorldObject const* obj, CellIdList& cells)
+{
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+
+    for(uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for(uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            // marked cells are those that will be visited
+            // don't visit the same cell twice
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if(!isCellMarked(cell_id))
+            {
+                markCell(cell_id);
+                cells.push_back(cell_id);
+            }
+        }
+    }
+}
+
+void Map::UpdateCells(CellIdList const& cells, uint32 diff)
+{
+    MaNGOS::ObjectUpdater updater(diff);
+    // for creature
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    // for pets
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    for(CellIdList::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
+}
+
+class CellRegionUpdateRequest : public MapUpdater::Request
+{
+    public:
+        CellRegionUpdateRequest(Map& map, Map::CellIdList& cells, uint32 diff) : m_map(map), m_diff(diff)
+        {
+            m_cells.swap(cells);
+        }
+
+        void call() { m_map.UpdateCells(m_cells, m_diff); }
+
+    private:
+        Map& m_map;
+        Map::CellIdList m_cells;
+        uint32 m_diff;
+};
+
+template<class T>
+void Map::ApplyDelayedAdd(Map& map, DelayedObjectChange const& change)
+{
+    map.Add(static_cast<T*>(change.obj));
+}
+
+template<class T>
+void Map::ApplyDelayedRemove(Map& map, DelayedObjectChange const& change)
+{
+    map.RemoveFromCell(static_cast<T*>(change.obj), change.remove, change.cell, change.active);
+}
+
+/**
+ * Update cells in independent regions by cell region updater threads.
+ *
+ * Regions are separated by not updated cells covering at least twice the map visibility distance (or
+ * MapUpdate.Region.Margin if larger), so objects of different regions can't reach each other or the same
+ * object between regions by melee, spells, aggro or visibility. Side effects that still can cross region
+ * borders (creature move to another cell, object add and remove, pool respawns, immediate map scripts)
+ * are delayed until all regions done. Respawn times of the map persistent state are locked instead.
+ *
+ * Not covered: interactions beyond visibility distance (spells with larger range, scripts acting on far
+ * objects by guid), such maps must keep MapUpdate.Region.Threads disabled or use larger margin.
+ * Instances, battlegrounds and maps with InstanceData script are always updated in one thread, their
+ * scripts and hooks are not thread safe.
+ */
+void Map::UpdateCellRegions(CellIdList const& cells, uint32 diff)
+{
+    if (Instanceable() || i_data)
+    {
+        UpdateCells(cells, diff);
+        return;
+    }
+
+    uint32 margin = uint32(ceil(2 * GetVisibilityDistance() / SIZE_OF_GRID_CELL));
+    margin = std::max(margin, sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_REGION_MARGIN));
+
+    CellRegionList regions;
+    SplitCellsToRegions(cells, margin, regions);
+
+    if (regions.size() < 2)
+    {
+        UpdateCells(cells, diff);
+        return;
+    }
+
+    MapUpdater& updater = sMapMgr.GetCellRegionUpdater();
+    MapUpdater::Batch batch;
+
+    m_cellRegionsUpdate = true;
+
+    for(CellRegionList::iterator itr = regions.begin(); itr != regions.end(); ++itr)
+        updater.Schedule(new CellRegionUpdateRequest(*this, *itr, diff), &batch);
+
+    updater.Wait(batch);
+
+    m_cellRegionsUpdate = false;
+
+    // relocations first, delayed remove can delete object
+    ProcessDelayedCreatureRelocations();
+    ProcessDelayedObjectChanges();
+    ProcessDelayedPoolUpdates();
+}
+
+void Map::SplitCellsToRegions(CellIdList const& cells, uint32 margin, CellRegionList& regions)
+{
+    // marked cell id -> region index
+    typedef UNORDERED_MAP<uint32, uint32> CellRegionMap;
+    const uint32 noRegion = uint32(-1);
+
+    CellRegionMap cellRegions;
+    for(CellIdList::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+        cellRegions[*itr] = noRegion;
+
+    CellIdList stack;
+    for(CellIdList::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        if (cellRegions[*itr] != noRegion)
+            continue;
+
+        // flood fill all marked cells that are closer than margin to already collected region cells
+        uint32 regionIdx = uint32(regions.size());
+        regions.push_back(CellIdList());
+
+        cellRegions[*itr] = regionIdx;
+        stack.push_back(*itr);
+
+        while (!stack.empty())
+        {
+            uint32 cell_id = stack.back();
+            stack.pop_back();
+            regions[regionIdx].push_back(cell_id);
+
+            int32 cell_x = cell_id % TOTAL_NUMBER_OF_CELLS_PER_MAP;
+            int32 cell_y = cell_id / TOTAL_NUMBER_OF_CELLS_PER_MAP;
+
+            int32 low_x = std::max(cell_x - int32(margin), 0);
+            int32 low_y = std::max(cell_y - int32(margin), 0);
+            int32 high_x = std::min(cell_x + int32(margin), int32(TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1);
+            int32 high_y = std::min(cell_y + int32(margin), int32(TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1);
+
+            for(int32 x = low_x; x <= high_x; ++x)
+            {
+                for(int32 y = low_y; y <= high_y; ++y)
+                {
+                    CellRegionMap::iterator near_itr = cellRegions.find(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x);
+                    if (near_itr != cellRegions.end() && near_itr->second == noRegion)
+                    {
+                        near_itr->second = regionIdx;
+                        stack.push_back(near_itr->first);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Map::ProcessDelayedCreatureRelocations()
+{
+    DelayedCreatureRelocations relocations;
+    relocations.swap(m_delayedCreatureRelocations);
+
+    for(DelayedCreatureRelocations::const_iterator itr = relocations.begin(); itr != relocations.end(); ++itr)
+    {
+        // creature can be removed from map at update in same tick
+        if (itr->creature->IsInWorld() && itr->creature->GetMap() == this)
+            CreatureRelocation(itr->creature, itr->x, itr->y, itr->z, itr->o);
+    }
+}
+
+void Map::ProcessRelocationNotifies()
+{
+    if (m_relocationNotifies.empty())
+        return;
+
+    // called outside parallel cell region update, new schedules from AI reactions go to next update
+    RelocationNotifies notifies;
+    notifies.swap(m_relocationNotifies);
+
+    uint32 now = WorldTimer::getMSTime();
+    uint32 limit = World::GetRelocationAINotifyLimit();
+
+    // cell id -> due mover, same unit moved several times since last notify is queued only once
+    typedef std::vector<std::pair<uint32, Unit*> > CellMovers;
+    CellMovers movers;
+
+    for(RelocationNotifies::const_iterator itr = notifies.begin(); itr != notifies.end(); ++itr)
+    {
+        // not due yet or over limit for one update, keep for next updates in same order
+        if (int32(now - itr->time) < 0 || (limit && movers.size() >= limit))
+        {
+            m_relocationNotifies.push_back(*itr);
+            continue;
+        }
+
+        // removed from map or already notified (scheduled again after re-add to world)
+        Unit* unit = GetUnit(itr->guid);
+        if (!unit || !unit->IsAINotifyScheduled())
+            continue;
+
+        unit->_SetAINotifyScheduled(false);
+
+        CellPair p = MaNGOS::ComputeCellPair(unit->GetPositionX(), unit->GetPositionY());
+        if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+            continue;
+
+        movers.push_back(CellMovers::value_type(p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord, unit));
+    }
+
+    if (movers.empty())
+        return;
+
+    std::sort(movers.begin(), movers.end());
+
+    float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+
+    MaNGOS::RelocationNotifier notifier;
+    TypeContainerVisitor<MaNGOS::RelocationNotifier, GridTypeMapContainer > grid_notifier(notifier);
+    TypeContainerVisitor<MaNGOS::RelocationNotifier, WorldTypeMapContainer > world_notifier(notifier);
+
+    std::vector<CellArea> areas;
+
+    // visit each cell around movers of one cell once for all of them
+    for(CellMovers::const_iterator group = movers.begin(); group != movers.end();)
+    {
+        CellMovers::const_iterator group_end = group;
+        areas.clear();
+
+        CellArea groupArea;
+        for(; group_end != movers.end() && group_end->first == group->first; ++group_end)
+        {
+            Unit* unit = group_end->second;
+            CellArea area = Cell::CalculateCellArea(unit->GetPositionX(), unit->GetPositionY(), radius + unit->GetObjectBoundingRadius());
+            if (areas.empty())
+                groupArea = area;
+            else
+            {
+                groupArea.low_bound.x_coord = std::min(groupArea.low_bound.x_coord, area.low_bound.x_coord);
+                groupArea.low_bound.y_coord = std::min(groupArea.low_bound.y_coord, area.low_bound.y_coord);
+                groupArea.high_bound.x_coord = std::max(groupArea.high_bound.x_coord, area.high_bound.x_coord);
+                groupArea.high_bound.y_coord = std::max(groupArea.high_bound.y_coord, area.high_bound.y_coord);
+            }
+            areas.push_back(area);
+        }
+
+        for(uint32 x = groupArea.low_bound.x_coord; x <= groupArea.high_bound.x_coord; ++x)
+        {
+            for(uint32 y = groupArea.low_bound.y_coord; y <= groupArea.high_bound.y_coord; ++y)
+            {
+                CellPair cellPair(x, y);
+
+                // only movers that would visit this cell with own aggro radius
+                notifier.i_players.clear();
+                notifier.i_creatures.clear();
+                for(size_t i = 0; i < areas.size(); ++i)
+                {
+                    if (!areas[i].IsInArea(cellPair))
+                        continue;
+
+                    Unit* unit = group[i].second;
+                    if (!unit->isAlive())
+                        continue;
+
+                    if (unit->GetTypeId() == TYPEID_PLAYER)
+                    {
+                        if (!unit->IsTaxiFlying())
+                            notifier.i_players.push_back((Player*)unit);
+                    }
+                    else
+                        notifier.i_creatures.push_back((Creature*)unit);
+                }
+
+                if (notifier.i_players.empty() && notifier.i_creatures.empty())
+                    continue;
+
+                Cell cell(cellPair);
+                cell.SetNoCreate();
+                Visit(cell, grid_notifier);
+                Visit(cell, world_notifier);
+            }
+        }
+
+        group = group_end;
+    }
+}
+
+void Map::ProcessDelayedObjectChanges()
+{
+    DelayedObjectChanges changes;
+    changes.swap(m_delayedObjectChanges);
+
+    // in call order, so remove and add of same object (relocation to far point, active state change) keep meaning
+    for(DelayedObjectChanges::const_iterator itr = changes.begin(); itr != changes.end(); ++itr)
+        (*itr->apply)(*this, *itr);
+}
+
+void Map::ProcessDelayedPoolUpdates()
+{
+    DelayedPoolUpdates updates;
+    updates.swap(m_delayedPoolUpdates);
+
+    for(DelayedPoolUpdates::const_iterator itr = updates.begin(); itr != updates.end(); ++itr)
+        (sPoolMgr.*itr->update)(*GetPersistentState(), itr->poolId, itr->dbGuid);
+}
+
 void Map::Remove(Player *player, bool remove)
 {
     if (i_data)
@@ -581,6 +892,10 @@ void Map::Remove(Player *player, bool remove)
     if(m_mapRefIter == player->GetMapRef())
         m_mapRefIter = m_mapRefIter->nocheck_prev();
     player->GetMapRef().unlink();
+
+    // movement of this map objects is outdated for player at new map
+    player->GetSession()->ClearMovementBatch();
+
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
     if(p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -626,6 +941,21 @@ Map::Remove(T *obj, bool remove)
         return;
     }
 
+    // remove after parallel cell update, from cell and active state at call time (caller can relocate
+    // object or change active state before it re-added)
+    if (m_cellRegionsUpdate)
+    {
+        SharedDataGuard guard(m_sharedDataLock);
+        m_delayedObjectChanges.push_back(DelayedObjectChange(&Map::ApplyDelayedRemove<T>, obj, p, remove, obj->isActiveObject()));
+        return;
+    }
+
+    RemoveFromCell(obj, remove, p, obj->isActiveObject());
+}
+
+template<class T>
+void Map::RemoveFromCell(T *obj, bool remove, CellPair const& p, bool active)
+{
     Cell cell(p);
     if( !loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)) )
         return;
@@ -634,7 +964,7 @@ Map::Remove(T *obj, bool remove)
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
     MANGOS_ASSERT( grid != NULL );
 
-    if(obj->isActiveObject())
+    if(active)
         RemoveFromActive(obj);
 
     if(remove)
@@ -703,6 +1033,14 @@ void Map::CreatureRelocation(Creature *creature, float x, float y, float z, floa
     Cell old_cell = creature->GetCurrentCell();
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
+    // move to another cell can touch cells of other region, apply it after parallel cell update
+    if (m_cellRegionsUpdate && old_cell != new_cell)
+    {
+        SharedDataGuard guard(m_sharedDataLock);
+        m_delayedCreatureRelocations.push_back(DelayedCreatureRelocation(creature, x, y, z, ang));
+        return;
+    }
+
     // do move or do move to respawn or remove creature if previous all fail
     if (CreatureCellRelocation(creature,new_cell))
     {
@@ -746,6 +1084,31 @@ bool Map::CreatureCellRelocation(Creature *c, Cell new_cell)
     return true;
 }
 
+void Map::SelectUnitsInRange(float x, float y, float radius, float boundingRadius, uint8 objectMask, CellPositionUnitList& units) const
+{
+    CellPair standing_cell = MaNGOS::ComputeCellPair(x, y);
+    if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return;
+
+    // cells limited like at Cell::Visit, distance filter use full radius
+    CellArea area = Cell::CalculateCellArea(x, y, radius > 333.0f ? 333.0f : radius);
+    float range = (radius > 0.0f ? radius : 0.0f) + boundingRadius;
+
+    for(uint32 cell_x = area.low_bound.x_coord; cell_x <= area.high_bound.x_coord; ++cell_x)
+    {
+        for(uint32 cell_y = area.low_bound.y_coord; cell_y <= area.high_bound.y_coord; ++cell_y)
+        {
+            Cell cell(CellPair(cell_x, cell_y));
+
+            // not load grids, same as visit with no create cell
+            if (!loaded(cell.gridPair()))
+                continue;
+
+            GetCellPositionIndex(cell).SelectInCircle(x, y, range, objectMask, units);
+        }
+    }
+}
+
 bool Map::CreatureRespawnRelocation(Creature *c)
 {
     float resp_x, resp_y, resp_z, resp_o;
@@ -783,6 +1146,8 @@ bool Map::UnloadGrid(const uint32 &x, const uint32 &y, bool pForce)
         DEBUG_LOG("Unloading grid[%u,%u] for map %u", x,y, i_id);
         ObjectGridUnloader unloader(*grid);
 
+        m_gridPreloader.ReleaseGrid(x, y);
+
         // Finish remove and delete all creatures with delayed remove before moving to respawn grids
         // Must know real mob position before move
         RemoveAllObjectsInRemoveList();
@@ -796,6 +1161,10 @@ bool Map::UnloadGrid(const uint32 &x, const uint32 &y, bool pForce)
         unloader.UnloadN();
         delete getNGrid(x, y);
         setNGrid(NULL, x, y);
+
+        // units already removed at unload, destructor only detach possible leftovers
+        delete[] m_cellPositionIndexes[x][y];
+        m_cellPositionIndexes[x][y] = NULL;
     }
 
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
@@ -881,6 +1250,26 @@ void Map::UpdateObjectVisibility( WorldObject* obj, Cell cell, CellPair cellpair
     cell.Visit(cellpair, player_notifier, *this, *obj, GetVisibilityDistance());
 }
 
+void Map::UpdateObjectVisibilityAfterMove(WorldObject* obj, float oldX, float oldY)
+{
+    CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+    Cell cell(p);
+
+    float dx = obj->GetPositionX() - oldX;
+    float dy = obj->GetPositionY() - oldY;
+    if (dx*dx + dy*dy > World::GetVisibilityIncrementalUpdateDistance() * World::GetVisibilityIncrementalUpdateDistance())
+    {
+        UpdateObjectVisibility(obj, cell, p);
+        return;
+    }
+
+    cell.SetNoCreate();
+    MaNGOS::VisibilityDeltaCheck check(oldX, oldY, obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+    MaNGOS::VisibleChangesNotifier notifier(*obj, &check);
+    TypeContainerVisitor<MaNGOS::VisibleChangesNotifier, WorldTypeMapContainer > player_notifier(notifier);
+    cell.Visit(p, player_notifier, *this, *obj, GetVisibilityDistance());
+}
+
 void Map::SendInitSelf( Player * player )
 {
     DETAIL_LOG("Creating player data for himself %u", player->GetGUIDLow());
@@ -979,6 +1368,7 @@ void Map::AddObjectToRemoveList(WorldObject *obj)
 
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
+    SharedDataGuard guard(m_sharedDataLock);
     i_objectsToRemove.insert(obj);
     //DEBUG_LOG("Object (GUID: %u TypeId: %u ) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
@@ -1080,6 +1470,8 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive( WorldObject* obj )
 {
+    SharedDataGuard guard(m_sharedDataLock);
+
     m_activeNonPlayers.insert(obj);
 
     // also not allow unloading spawn grid to prevent creating creature clone at load
@@ -1106,16 +1498,10 @@ void Map::AddToActive( WorldObject* obj )
 
 void Map::RemoveFromActive( WorldObject* obj )
 {
-    // Map::Update for active object in proccess
-    if(m_activeNonPlayersIter != m_activeNonPlayers.end())
-    {
-        ActiveNonPlayers::iterator itr = m_activeNonPlayers.find(obj);
-        if(itr==m_activeNonPlayersIter)
-            ++m_activeNonPlayersIter;
-        m_activeNonPlayers.erase(itr);
-    }
-    else
-        m_activeNonPlayers.erase(obj);
+    SharedDataGuard guard(m_sharedDataLock);
+
+    // active objects list is not iterated while objects are updated (cells collected before), safe to erase
+    m_activeNonPlayers.erase(obj);
 
     // also allow unloading spawn grid
     if (obj->GetTypeId()==TYPEID_UNIT)
@@ -1623,14 +2009,18 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sa.ownerGuid  = ownerGuid;
 
         sa.script = &iter->second;
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->first), sa));
+        {
+            SharedDataGuard guard(m_sharedDataLock);
+            m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->first), sa));
+        }
         if (iter->first == 0)
             immedScript = true;
 
         sScriptMgr.IncreaseScheduledScriptsCount();
     }
     ///- If one of the effects should be immediate, launch the script execution
-    if (immedScript)
+    ///- (at parallel cell update scripts can affect other regions, they will be processed at end of map update)
+    if (immedScript && !m_cellRegionsUpdate)
         ScriptsProcess();
 }
 
@@ -1649,12 +2039,15 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGuid  = ownerGuid;
 
     sa.script = &script;
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+    {
+        SharedDataGuard guard(m_sharedDataLock);
+        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+    }
 
     sScriptMgr.IncreaseScheduledScriptsCount();
 
     ///- If effects should be immediate, launch the script execution
-    if(delay == 0)
+    if(delay == 0 && !m_cellRegionsUpdate)
         ScriptsProcess();
 }
 
@@ -2994,6 +3387,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    ObjectsStoreReadGuard guard(m_objectsStoreLock);
     return m_objectsStore.find<Creature>(guid, (Creature*)NULL);
 }
 
@@ -3004,6 +3398,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    ObjectsStoreReadGuard guard(m_objectsStoreLock);
     return m_objectsStore.find<Pet>(guid, (Pet*)NULL);
 }
 
@@ -3045,6 +3440,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    ObjectsStoreReadGuard guard(m_objectsStoreLock);
     return m_objectsStore.find<GameObject>(guid, (GameObject*)NULL);
 }
 
@@ -3055,6 +3451,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    ObjectsStoreReadGuard guard(m_objectsStoreLock);
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)NULL);
 }
 
@@ -3112,12 +3509,12 @@ void Map::SendObjectUpdates()
         obj->BuildUpdateData(update_players);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    // players near each other often get same update, build and compress it only once
+    UpdatePacketCache packets;
     for(UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        if (SharedPacket* packet = packets.GetPacket(iter->second))
+            iter->first->GetSession()->SendPacket(*packet);
     }
 }
 
@@ -28,6 +28,8 @@
 #include "DBCStructure.h"
 #include "GridDefines.h"
 #include "Cell.h"
+#include "CellPositionIndex.h"
+#include "GridPreloader.h"
 #include "Object.h"
 #include "Timer.h"
 #include "SharedDefines.h"
@@ -53,6 +55,7 @@ class BattleGroundPersistentState;
 struct ScriptInfo;
 class BattleGround;
 class GridMap;
+class PoolManager;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -93,8 +96,10 @@ enum LevelRequirementVsMode
 class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
+    friend class GridPreloader;
     friend class ObjectGridLoader;
     friend class ObjectWorldLoader;
+    friend class CellRegionUpdateRequest;
 
     protected:
         Map(uint32 id, time_t, uint32 InstanceId, uint8 SpawnMode);
@@ -113,6 +118,8 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         virtual bool Add(Player *);
         virtual void Remove(Player *, bool);
+        // while IsCellRegionsUpdateInProgress() the object is only queued and gets IsInWorld() after all regions
+        // updated, so callers (summons passed to JustSummoned, script spawns) must not rely on it being in world yet
         template<class T> void Add(T *);
         template<class T> void Remove(T *, bool);
 
@@ -134,6 +141,14 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER> &visitor);
 
+        // candidates for range checks from cell position indexes of loaded grids, without touching objects
+        // cells selected like Cell::Visit for radius, distance filter is radius + boundingRadius + unit's own bounding radius
+        void SelectUnitsInRange(float x, float y, float radius, float boundingRadius, uint8 objectMask, CellPositionUnitList& units) const;
+        void SelectUnitsInRange(WorldObject const* obj, float radius, uint8 objectMask, CellPositionUnitList& units) const
+        {
+            SelectUnitsInRange(obj->GetPositionX(), obj->GetPositionY(), radius + obj->GetObjectBoundingRadius(), 0.0f, objectMask, units);
+        }
+
         bool IsRemovalGrid(float x, float y) const
         {
             GridPair p = MaNGOS::ComputeGridPair(x, y);
@@ -199,6 +214,8 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject *obj);
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
+        // update visibility of moved object only for cameras which distance to it crossed visibility distance
+        void UpdateObjectVisibilityAfterMove(WorldObject* obj, float oldX, float oldY);
 
         void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
@@ -233,18 +250,51 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         WorldObject* GetWorldObject(ObjectGuid guid);       // only use if sure that need objects at current map, specially for player case
 
         typedef TypeUnorderedMapContainer<AllMapStoredObjectTypes, ObjectGuid> MapStoredObjectTypesContainer;
-        MapStoredObjectTypesContainer& GetObjectsStore() { return m_objectsStore; }
+
+        // object store can be modified from parallel cell region updates, so access only by lock
+        template<class T> void InsertObject(ObjectGuid const& guid, T* obj)
+        {
+            ObjectsStoreWriteGuard guard(m_objectsStoreLock);
+            m_objectsStore.insert<T>(guid, obj);
+        }
+
+        template<class T> void EraseObject(ObjectGuid const& guid)
+        {
+            ObjectsStoreWriteGuard guard(m_objectsStoreLock);
+            m_objectsStore.erase<T>(guid, (T*)NULL);
+        }
 
         void AddUpdateObject(Object *obj)
         {
+            SharedDataGuard guard(m_sharedDataLock);
             i_objectsToClientUpdate.insert(obj);
         }
 
         void RemoveUpdateObject(Object *obj)
         {
+            SharedDataGuard guard(m_sharedDataLock);
             i_objectsToClientUpdate.erase( obj );
         }
 
+        // true while cells updated in parallel regions, cross-cell side effects must be deferred
+        bool IsCellRegionsUpdateInProgress() const { return m_cellRegionsUpdate; }
+
+        typedef void (PoolManager::*PoolUpdateHandler)(MapPersistentState& mapState, uint16 pool_id, uint32 db_guid_or_pool_id);
+
+        // pool update can spawn and despawn objects in other region, applied after parallel cell update
+        void AddDelayedPoolUpdate(PoolUpdateHandler update, uint16 pool_id, uint32 db_guid_or_pool_id)
+        {
+            SharedDataGuard guard(m_sharedDataLock);
+            m_delayedPoolUpdates.push_back(DelayedPoolUpdate(update, pool_id, db_guid_or_pool_id));
+        }
+
+        // queue unit moves for AI notify of nearby units, processed once per map update
+        void ScheduleRelocationNotify(ObjectGuid const& guid, uint32 delay)
+        {
+            SharedDataGuard guard(m_sharedDataLock);
+            m_relocationNotifies.push_back(RelocationNotify(guid, WorldTimer::getMSTime() + delay));
+        }
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -292,11 +342,80 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void setGridObjectDataLoaded(bool pLoaded, uint32 x, uint32 y) { getNGrid(x,y)->setGridObjectDataLoaded(pLoaded); }
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
+        CellPositionIndex& GetCellPositionIndex(Cell const& cell) const
+        {
+            return m_cellPositionIndexes[cell.GridX()][cell.GridY()][cell.CellY() * MAX_NUMBER_OF_CELLS + cell.CellX()];
+        }
         void ScriptsProcess();
 
         void SendObjectUpdates();
         std::set<Object *> i_objectsToClientUpdate;
 
+        typedef std::vector<uint32> CellIdList;
+        typedef std::vector<CellIdList> CellRegionList;
+
+        void MarkCellsAround(WorldObject const* obj, CellIdList& cells);
+        void UpdateCells(CellIdList const& cells, uint32 diff);
+        void UpdateCellRegions(CellIdList const& cells, uint32 diff);
+        static void SplitCellsToRegions(CellIdList const& cells, uint32 margin, CellRegionList& regions);
+        void ProcessDelayedCreatureRelocations();
+        void ProcessDelayedObjectChanges();
+        void ProcessDelayedPoolUpdates();
+
+        template<class T> void RemoveFromCell(T *obj, bool remove, CellPair const& p, bool active);
+
+        struct DelayedObjectChange;
+        typedef void (*DelayedObjectChangeHandler)(Map& map, DelayedObjectChange const& change);
+
+        // Add or Remove call made while cells updated in parallel regions
+        struct DelayedObjectChange
+        {
+            DelayedObjectChange(DelayedObjectChangeHandler _apply, WorldObject* _obj) :
+                apply(_apply), obj(_obj), remove(false), active(false) {}
+            DelayedObjectChange(DelayedObjectChangeHandler _apply, WorldObject* _obj, CellPair const& _cell, bool _remove, bool _active) :
+                apply(_apply), obj(_obj), cell(_cell), remove(_remove), active(_active) {}
+
+            DelayedObjectChangeHandler apply;
+            WorldObject* obj;
+            CellPair cell;                                  // object cell at Remove call
+            bool remove;                                    // delete object at Remove
+            bool active;                                    // active object at Remove call
+        };
+        typedef std::vector<DelayedObjectChange> DelayedObjectChanges;
+
+        template<class T> static void ApplyDelayedAdd(Map& map, DelayedObjectChange const& change);
+        template<class T> static void ApplyDelayedRemove(Map& map, DelayedObjectChange const& change);
+
+        struct DelayedCreatureRelocation
+        {
+            DelayedCreatureRelocation(Creature* c, float _x, float _y, float _z, float _o) : creature(c), x(_x), y(_y), z(_z), o(_o) {}
+
+            Creature* creature;
+            float x, y, z, o;
+        };
+        typedef std::vector<DelayedCreatureRelocation> DelayedCreatureRelocations;
+
+        struct DelayedPoolUpdate
+        {
+            DelayedPoolUpdate(PoolUpdateHandler _update, uint16 _poolId, uint32 _dbGuid) : update(_update), poolId(_poolId), dbGuid(_dbGuid) {}
+
+            PoolUpdateHandler update;
+            uint16 poolId;
+            uint32 dbGuid;                                  // despawned object db guid or child pool id
+        };
+        typedef std::vector<DelayedPoolUpdate> DelayedPoolUpdates;
+
+        void ProcessRelocationNotifies();
+
+        struct RelocationNotify
+        {
+            RelocationNotify(ObjectGuid const& _guid, uint32 _time) : guid(_guid), time(_time) {}
+
+            ObjectGuid guid;
+            uint32 time;                                    // WorldTimer::getMSTime() when notify is due
+        };
+        typedef std::vector<RelocationNotify> RelocationNotifies;
+
     protected:
         MapEntry const* i_mapEntry;
         uint8 i_spawnMode;
@@ -311,13 +430,26 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         typedef std::set<WorldObject*> ActiveNonPlayers;
         ActiveNonPlayers m_activeNonPlayers;
-        ActiveNonPlayers::iterator m_activeNonPlayersIter;
         MapStoredObjectTypesContainer m_objectsStore;
 
+        typedef ACE_RW_Thread_Mutex ObjectsStoreLock;
+        typedef ACE_Read_Guard<ObjectsStoreLock> ObjectsStoreReadGuard;
+        typedef ACE_Write_Guard<ObjectsStoreLock> ObjectsStoreWriteGuard;
+        ObjectsStoreLock m_objectsStoreLock;
+
+        // protect containers shared by all cells (client update, remove, active and script lists)
+        typedef ACE_Thread_Mutex SharedDataLock;
+        typedef ACE_Guard<SharedDataLock> SharedDataGuard;
+        SharedDataLock m_sharedDataLock;
+
     private:
         time_t i_gridExpiry;
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        // per created grid MAX_NUMBER_OF_CELLS*MAX_NUMBER_OF_CELLS cell unit position indexes
+        CellPositionIndex* m_cellPositionIndexes[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+
+        GridPreloader m_gridPreloader;
 
         //Shared geodata object with map coord info...
         TerrainInfo * const m_TerrainData;
@@ -327,6 +459,12 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         std::set<WorldObject *> i_objectsToRemove;
 
+        bool m_cellRegionsUpdate;
+        DelayedCreatureRelocations m_delayedCreatureRelocations;
+        DelayedObjectChanges m_delayedObjectChanges;
+        DelayedPoolUpdates m_delayedPoolUpdates;
+        RelocationNotifies m_relocationNotifies;
+
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
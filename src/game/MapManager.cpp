@@ -40,6 +40,10 @@ MapManager::MapManager()
 
 MapManager::~MapManager()
 {
+    m_updater.Deactivate();
+    m_regionUpdater.Deactivate();
+    m_gridPreloadUpdater.Deactivate();
+
     for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
         delete iter->second;
 
@@ -53,6 +57,15 @@ void
 MapManager::Initialize()
 {
     InitStateMachine();
+
+    if (uint32 threads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_THREADS))
+        m_updater.Activate(threads);
+
+    if (uint32 threads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_REGION_THREADS))
+        m_regionUpdater.Activate(threads);
+
+    if (uint32 threads = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS))
+        m_gridPreloadUpdater.Activate(threads);
 }
 
 void MapManager::InitStateMachine()
@@ -230,8 +243,19 @@ MapManager::Update(uint32 diff)
     if( !i_timer.Passed() )
         return;
 
-    for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
-        iter->second->Update((uint32)i_timer.GetCurrent());
+    if (m_updater.IsActive())
+    {
+        for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
+            m_updater.ScheduleUpdate(*iter->second, (uint32)i_timer.GetCurrent());
+
+        // barrier: transports, map unload and all later world update steps can touch several maps
+        m_updater.Wait();
+    }
+    else
+    {
+        for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
+            iter->second->Update((uint32)i_timer.GetCurrent());
+    }
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
     {
@@ -284,6 +308,10 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    m_updater.Deactivate();
+    m_regionUpdater.Deactivate();
+    m_gridPreloadUpdater.Deactivate();
+
     for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
@@ -25,6 +25,7 @@
 #include "ace/Recursive_Thread_Mutex.h"
 #include "Map.h"
 #include "GridStates.h"
+#include "MapUpdater.h"
 
 class Transport;
 class BattleGround;
@@ -150,6 +151,11 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         //get list of all maps
         const MapMapType& Maps() const { return i_maps; }
 
+        // thread pool for parallel cell region updates inside single map
+        MapUpdater& GetCellRegionUpdater() { return m_regionUpdater; }
+        // thread pool reading terrain of grids ahead of players, see GridPreloader
+        MapUpdater& GetGridPreloadUpdater() { return m_gridPreloadUpdater; }
+
         template<typename Do>
         void DoForAllMapsWithMapId(uint32 mapId, Do& _do);
 
@@ -177,6 +183,9 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         uint32 i_gridCleanUpDelay;
         MapMapType i_maps;
         IntervalTimer i_timer;
+        MapUpdater m_updater;
+        MapUpdater m_regionUpdater;
+        MapUpdater m_gridPreloadUpdater;
 };
 
 template<typename Do>
@@ -120,30 +120,48 @@ void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::SetCreatureRespawnTime( uint32 loguid, time_t t )
 {
-    if (t > sWorld.GetGameTime())
-        m_creatureRespawnTimes[loguid] = t;
-    else
     {
+        RespawnTimesGuard guard(m_respawnTimesLock);
+
+        if (t > sWorld.GetGameTime())
+        {
+            m_creatureRespawnTimes[loguid] = t;
+            return;
+        }
+
         m_creatureRespawnTimes.erase(loguid);
-        UnloadIfEmpty();
     }
+
+    // world states (the only updated in parallel cell regions) never unload, so unlocked call is safe
+    UnloadIfEmpty();
 }
 
 void MapPersistentState::SetGORespawnTime( uint32 loguid, time_t t )
 {
-    if (t > sWorld.GetGameTime())
-        m_goRespawnTimes[loguid] = t;
-    else
     {
+        RespawnTimesGuard guard(m_respawnTimesLock);
+
+        if (t > sWorld.GetGameTime())
+        {
+            m_goRespawnTimes[loguid] = t;
+            return;
+        }
+
         m_goRespawnTimes.erase(loguid);
-        UnloadIfEmpty();
     }
+
+    // world states (the only updated in parallel cell regions) never unload, so unlocked call is safe
+    UnloadIfEmpty();
 }
 
 void MapPersistentState::ClearRespawnTimes()
 {
-    m_goRespawnTimes.clear();
-    m_creatureRespawnTimes.clear();
+    {
+        RespawnTimesGuard guard(m_respawnTimesLock);
+
+        m_goRespawnTimes.clear();
+        m_creatureRespawnTimes.clear();
+    }
 
     UnloadIfEmpty();
 }
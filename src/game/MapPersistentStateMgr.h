@@ -90,12 +90,14 @@ class MapPersistentState
 
         time_t GetCreatureRespawnTime(uint32 loguid) const
         {
+            RespawnTimesGuard guard(m_respawnTimesLock);
             RespawnTimes::const_iterator itr = m_creatureRespawnTimes.find(loguid);
             return itr != m_creatureRespawnTimes.end() ? itr->second : 0;
         }
         void SaveCreatureRespawnTime(uint32 loguid, time_t t);
         time_t GetGORespawnTime(uint32 loguid) const
         {
+            RespawnTimesGuard guard(m_respawnTimesLock);
             RespawnTimes::const_iterator itr = m_goRespawnTimes.find(loguid);
             return itr != m_goRespawnTimes.end() ? itr->second : 0;
         }
@@ -119,7 +121,11 @@ class MapPersistentState
 
         bool UnloadIfEmpty();
         void ClearRespawnTimes();
-        bool HasRespawnTimes() const { return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty(); }
+        bool HasRespawnTimes() const
+        {
+            RespawnTimesGuard guard(m_respawnTimesLock);
+            return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty();
+        }
 
     private:
         void SetCreatureRespawnTime(uint32 loguid, time_t t);
@@ -128,6 +134,10 @@ class MapPersistentState
     private:
         typedef UNORDERED_MAP<uint32, time_t> RespawnTimes;
 
+        // respawn times are saved by creatures and gameobjects updated in parallel map cell regions
+        typedef ACE_Thread_Mutex RespawnTimesLock;
+        typedef ACE_Guard<RespawnTimesLock> RespawnTimesGuard;
+
         uint32 m_instanceid;
         uint32 m_mapid;
         Difficulty m_difficulty;
@@ -136,6 +146,7 @@ class MapPersistentState
         // persistent data
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
+        mutable RespawnTimesLock m_respawnTimesLock;
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
 };
 
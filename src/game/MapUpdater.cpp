@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapUpdater.h"
+#include "Map.h"
+#include "Log.h"
+#include "Database/DatabaseEnv.h"
+
+class MapUpdateRequest : public MapUpdater::Request
+{
+    public:
+        MapUpdateRequest(Map& map, uint32 diff) : m_map(map), m_diff(diff) {}
+
+        void call() { m_map.Update(m_diff); }
+
+    private:
+        Map& m_map;
+        uint32 m_diff;
+};
+
+class MapUpdateWorker : public ACE_Based::Runnable
+{
+    public:
+        explicit MapUpdateWorker(MapUpdater& updater) : m_updater(updater) {}
+
+        void run()
+        {
+            // maps can do sync DB requests (at creature respawn load, pet load, etc)
+            WorldDatabase.ThreadStart();
+
+            while (MapUpdater::Request* request = m_updater.NextRequest())
+            {
+                request->call();
+                m_updater.RequestDone(request);
+            }
+
+            WorldDatabase.ThreadEnd();
+        }
+
+    private:
+        MapUpdater& m_updater;
+};
+
+MapUpdater::MapUpdater() : m_requestCondition(m_lock), m_doneCondition(m_lock), m_pending(0), m_stopping(false)
+{
+}
+
+MapUpdater::~MapUpdater()
+{
+    Deactivate();
+}
+
+void MapUpdater::Activate(uint32 num_threads)
+{
+    if (IsActive() || !num_threads)
+        return;
+
+    m_stopping = false;
+
+    for (uint32 i = 0; i < num_threads; ++i)
+        m_workers.push_back(new ACE_Based::Thread(new MapUpdateWorker(*this)));
+
+    sLog.outString("Map updater started with %u threads", num_threads);
+}
+
+void MapUpdater::Deactivate()
+{
+    if (!IsActive())
+        return;
+
+    Wait();
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+        m_stopping = true;
+        m_requestCondition.broadcast();
+    }
+
+    for (WorkerThreads::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+        (*itr)->wait();
+        delete *itr;
+    }
+
+    m_workers.clear();
+}
+
+void MapUpdater::ScheduleUpdate(Map& map, uint32 diff)
+{
+    Schedule(new MapUpdateRequest(map, diff));
+}
+
+void MapUpdater::Schedule(Request* request, Batch* batch /*= NULL*/)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    request->m_batch = batch;
+    if (batch)
+        ++batch->m_pending;
+
+    ++m_pending;
+    m_queue.push_back(request);
+    m_requestCondition.signal();
+}
+
+void MapUpdater::Wait()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    while (m_pending > 0)
+        m_doneCondition.wait();
+}
+
+void MapUpdater::Wait(Batch& batch)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    while (batch.m_pending > 0)
+    {
+        // help workers instead of sleeping, queued requests never wait for other requests
+        if (!m_queue.empty())
+        {
+            Request* request = m_queue.front();
+            m_queue.pop_front();
+
+            guard.release();
+            request->call();
+            guard.acquire();
+
+            FinishRequest(request);
+        }
+        else
+            m_doneCondition.wait();
+    }
+}
+
+MapUpdater::Request* MapUpdater::NextRequest()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    while (m_queue.empty())
+    {
+        if (m_stopping)
+            return NULL;
+
+        m_requestCondition.wait();
+    }
+
+    Request* request = m_queue.front();
+    m_queue.pop_front();
+    return request;
+}
+
+void MapUpdater::RequestDone(Request* request)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+    FinishRequest(request);
+}
+
+void MapUpdater::FinishRequest(Request* request)
+{
+    MANGOS_ASSERT(m_pending > 0);
+
+    bool notify = --m_pending == 0;
+
+    if (Batch* batch = request->m_batch)
+    {
+        MANGOS_ASSERT(batch->m_pending > 0);
+        if (--batch->m_pending == 0)
+            notify = true;
+    }
+
+    delete request;
+
+    if (notify)
+        m_doneCondition.broadcast();
+}
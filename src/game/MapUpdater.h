@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPUPDATER_H
+#define MANGOS_MAPUPDATER_H
+
+#include "Common.h"
+#include "Threading.h"
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+class Map;
+
+/**
+ * Pool of worker threads used by MapManager to update independent Map instances concurrently.
+ *
+ * World thread schedules every map for the tick and then calls Wait(), which acts as a barrier:
+ * it returns only when all scheduled Map::Update calls have finished. Everything that touches
+ * more than one map (battlegrounds, transports, remove lists, far teleport completion at
+ * MSG_MOVE_WORLDPORT_ACK) keeps running in the world thread after that barrier.
+ *
+ * Same pool type is used for cell region updates inside one map, see Map::UpdateCellRegions.
+ */
+class MapUpdater
+{
+    public:
+        class Batch;
+
+        // unit of work executed by one of worker threads, deleted after execution
+        class Request
+        {
+            public:
+                Request() : m_batch(NULL) {}
+                virtual ~Request() {}
+
+                virtual void call() = 0;
+
+            private:
+                friend class MapUpdater;
+                Batch* m_batch;
+        };
+
+        // group of requests that caller can wait for independently from other requests in pool
+        class Batch
+        {
+            public:
+                Batch() : m_pending(0) {}
+
+            private:
+                friend class MapUpdater;
+                uint32 m_pending;
+        };
+
+        MapUpdater();
+        ~MapUpdater();
+
+        // start num_threads workers, 0 keep updater inactive (maps updated in caller thread)
+        void Activate(uint32 num_threads);
+        // stop and join all workers, pending requests are processed before
+        void Deactivate();
+
+        bool IsActive() const { return !m_workers.empty(); }
+        uint32 GetThreadsCount() const { return uint32(m_workers.size()); }
+
+        void ScheduleUpdate(Map& map, uint32 diff);
+        // updater take ownership of request
+        void Schedule(Request* request, Batch* batch = NULL);
+
+        // block caller until all scheduled requests are done
+        void Wait();
+        // block caller until batch requests are done, caller execute queued requests meanwhile
+        void Wait(Batch& batch);
+
+    private:
+        friend class MapUpdateWorker;
+
+        // used by workers: block until request available, return NULL at deactivation
+        Request* NextRequest();
+        void RequestDone(Request* request);
+        // must be called with m_lock held
+        void FinishRequest(Request* request);
+
+        typedef std::deque<Request*> RequestQueue;
+        typedef std::vector<ACE_Based::Thread*> WorkerThreads;
+
+        ACE_Thread_Mutex m_lock;
+        ACE_Condition_Thread_Mutex m_requestCondition;      // signaled at new request or deactivation
+        ACE_Condition_Thread_Mutex m_doneCondition;         // signaled when request or batch processed
+
+        RequestQueue m_queue;
+        uint32 m_pending;                                   // scheduled and not finished requests
+        bool m_stopping;
+
+        WorkerThreads m_workers;
+};
+
+#endif
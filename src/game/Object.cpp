@@ -28,6 +28,7 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "UpdateData.h"
+#include "SharedPacket.h"
 #include "UpdateMask.h"
 #include "Util.h"
 #include "MapManager.h"
@@ -40,6 +41,7 @@
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "ObjectPosSelector.h"
+#include "CellPositionIndex.h"
 #include "TemporarySummon.h"
 #include "movement/packet_builder.h"
 
@@ -117,12 +119,11 @@ void Object::SendForcedObjectUpdate()
     BuildUpdateData(update_players);
     RemoveFromClientUpdateList();
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    UpdatePacketCache packets;
     for(UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        if (SharedPacket* packet = packets.GetPacket(iter->second))
+            iter->first->GetSession()->SendPacket(*packet);
     }
 }
 
@@ -928,10 +929,16 @@ void Object::MarkForClientUpdate()
 }
 
 WorldObject::WorldObject()
-    : m_isActiveObject(false), m_currMap(NULL), m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL)
+    : m_isActiveObject(false), m_currMap(NULL), m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL),
+    m_cellPositionIndex(NULL), m_cellPositionSlot(0)
 {
 }
 
+WorldObject::~WorldObject()
+{
+    CellPositionIndex::Remove(this);
+}
+
 void WorldObject::CleanupsBeforeDelete()
 {
     RemoveFromWorld();
@@ -952,6 +959,8 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
 
     if(isType(TYPEMASK_UNIT))
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
+
+    CellPositionIndex::Update(this);
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -962,6 +971,8 @@ void WorldObject::Relocate(float x, float y, float z)
 
     if(isType(TYPEMASK_UNIT))
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+
+    CellPositionIndex::Update(this);
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1500,6 +1511,21 @@ void WorldObject::SendMessageToSetExcept(WorldPacket *data, Player const* skippe
     }
 }
 
+void WorldObject::SendMovementMessageToSetExcept(WorldPacket *data, Player const* skipped_receiver)
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_MOVEMENT_AGGREGATION))
+    {
+        SendMessageToSetExcept(data, skipped_receiver);
+        return;
+    }
+
+    if (IsInWorld())
+    {
+        MaNGOS::MovementMessageDeliverer notifier(*this, *data, skipped_receiver, sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_AGGREGATION_NEAR_DISTANCE));
+        Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
+    }
+}
+
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
@@ -1568,6 +1594,7 @@ Creature* WorldObject::SummonCreature(uint32 id, float x, float y, float z, floa
 
     pCreature->Summon(spwtype, despwtime);
 
+    // summon can be not in world yet here if map cells updated in parallel regions (see Map::Add)
     if(GetTypeId()==TYPEID_UNIT && ((Creature*)this)->AI())
         ((Creature*)this)->AI()->JustSummoned(pCreature);
 
@@ -70,6 +70,7 @@ class Map;
 class UpdateMask;
 class InstanceData;
 class TerrainInfo;
+class CellPositionIndex;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
@@ -404,6 +405,8 @@ struct WorldObjectChangeAccumulator;
 
 class MANGOS_DLL_SPEC WorldObject : public Object
 {
+    friend class CellPositionIndex;
+
     friend struct WorldObjectChangeAccumulator;
 
     public:
@@ -429,7 +432,7 @@ class MANGOS_DLL_SPEC WorldObject : public Object
                 WorldObject * const m_obj;
         };
 
-        virtual ~WorldObject ( ) {}
+        virtual ~WorldObject ( );
 
         virtual void Update(uint32 /*update_diff*/, uint32 /*time_diff*/) {}
 
@@ -531,6 +534,8 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         virtual void SendMessageToSet(WorldPacket *data, bool self);
         virtual void SendMessageToSetInRange(WorldPacket *data, float dist, bool self);
         void SendMessageToSetExcept(WorldPacket *data, Player const* skipped_receiver);
+        // same for client movement packets, batched with Network.MovementAggregation
+        void SendMovementMessageToSetExcept(WorldPacket *data, Player const* skipped_receiver);
 
         void MonsterSay(const char* text, uint32 language, Unit* target = NULL);
         void MonsterYell(const char* text, uint32 language, Unit* target = NULL);
@@ -606,6 +611,9 @@ class MANGOS_DLL_SPEC WorldObject : public Object
 
         Position m_position;
 
+        CellPositionIndex* m_cellPositionIndex;             // cell position mirror for range filters, units only
+        uint32 m_cellPositionSlot;
+
         ViewPoint m_viewPoint;
 
         WorldUpdateCounter m_updateTracker;
@@ -95,19 +95,20 @@ class ObjectWorldLoader
         uint32 i_corpses;
 };
 
-template<class T> void addUnitState(T* /*obj*/, CellPair const& /*cell_pair*/)
+template<class T> void addUnitState(T* /*obj*/, CellPair const& /*cell_pair*/, CellPositionIndex& /*positions*/)
 {
 }
 
-template<> void addUnitState(Creature *obj, CellPair const& cell_pair)
+template<> void addUnitState(Creature *obj, CellPair const& cell_pair, CellPositionIndex& positions)
 {
     Cell cell(cell_pair);
 
     obj->SetCurrentCell(cell);
+    positions.Insert(obj, CELL_POSITION_GRID_OBJECT);
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellPair &cell, GridRefManager<T> &m, uint32 &count, Map* map, GridType& grid)
+void LoadHelper(CellGuidSet const& guid_set, CellPair &cell, GridRefManager<T> &m, uint32 &count, Map* map, GridType& grid, CellPositionIndex& positions)
 {
     BattleGround* bg = map->IsBattleGroundOrArena() ? ((BattleGroundMap*)map)->GetBG() : NULL;
 
@@ -125,7 +126,7 @@ void LoadHelper(CellGuidSet const& guid_set, CellPair &cell, GridRefManager<T> &
 
         grid.AddGridObject(obj);
 
-        addUnitState(obj,cell);
+        addUnitState(obj, cell, positions);
         obj->SetMap(map);
         obj->AddToWorld();
         if(obj->isActiveObject())
@@ -158,7 +159,6 @@ void LoadHelper(CellCorpseSet const& cell_corpses, CellPair &cell, CorpseMapType
 
         grid.AddWorldObject(obj);
 
-        addUnitState(obj,cell);
         obj->SetMap(map);
         obj->AddToWorld();
         if (obj->isActiveObject())
@@ -179,8 +179,9 @@ ObjectGridLoader::Visit(GameObjectMapType &m)
     CellObjectGuids const& cell_guids = sObjectMgr.GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cell_id);
 
     GridType& grid = (*i_map->getNGrid(i_cell.GridX(),i_cell.GridY())) (i_cell.CellX(),i_cell.CellY());
-    LoadHelper(cell_guids.gameobjects, cell_pair, m, i_gameObjects, i_map, grid);
-    LoadHelper(i_map->GetPersistentState()->GetCellObjectGuids(cell_id).gameobjects, cell_pair, m, i_gameObjects, i_map, grid);
+    CellPositionIndex& positions = i_map->GetCellPositionIndex(i_cell);
+    LoadHelper(cell_guids.gameobjects, cell_pair, m, i_gameObjects, i_map, grid, positions);
+    LoadHelper(i_map->GetPersistentState()->GetCellObjectGuids(cell_id).gameobjects, cell_pair, m, i_gameObjects, i_map, grid, positions);
 }
 
 void
@@ -194,8 +195,9 @@ ObjectGridLoader::Visit(CreatureMapType &m)
     CellObjectGuids const& cell_guids = sObjectMgr.GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cell_id);
 
     GridType& grid = (*i_map->getNGrid(i_cell.GridX(),i_cell.GridY())) (i_cell.CellX(),i_cell.CellY());
-    LoadHelper(cell_guids.creatures, cell_pair, m, i_creatures, i_map, grid);
-    LoadHelper(i_map->GetPersistentState()->GetCellObjectGuids(cell_id).creatures, cell_pair, m, i_creatures, i_map, grid);
+    CellPositionIndex& positions = i_map->GetCellPositionIndex(i_cell);
+    LoadHelper(cell_guids.creatures, cell_pair, m, i_creatures, i_map, grid, positions);
+    LoadHelper(i_map->GetPersistentState()->GetCellObjectGuids(cell_id).creatures, cell_pair, m, i_creatures, i_map, grid, positions);
 }
 
 void
@@ -228,20 +230,24 @@ ObjectGridLoader::Load(GridType &grid)
     }
 }
 
-void ObjectGridLoader::LoadN(void)
+void ObjectGridLoader::LoadCells(uint32 firstCell, uint32 lastCell)
 {
-    i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
-    i_cell.data.Part.cell_y = 0;
-    for(unsigned int x=0; x < MAX_NUMBER_OF_CELLS; ++x)
+    for(uint32 idx = firstCell; idx < lastCell; ++idx)
     {
+        uint32 x = idx / MAX_NUMBER_OF_CELLS;
+        uint32 y = idx % MAX_NUMBER_OF_CELLS;
+
         i_cell.data.Part.cell_x = x;
-        for(unsigned int y=0; y < MAX_NUMBER_OF_CELLS; ++y)
-        {
-            i_cell.data.Part.cell_y = y;
-            GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
-            loader.Load(i_grid(x, y), *this);
-        }
+        i_cell.data.Part.cell_y = y;
+        GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
+        loader.Load(i_grid(x, y), *this);
     }
+}
+
+void ObjectGridLoader::LoadN(uint32 firstCell /*= 0*/)
+{
+    i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
+    LoadCells(firstCell, MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS);
     DEBUG_LOG("%u GameObjects, %u Creatures, and %u Corpses/Bones loaded for grid %u on map %u", i_gameObjects, i_creatures, i_corpses,i_grid.GetGridId(), i_map->GetId());
 }
 
@@ -44,7 +44,10 @@ class MANGOS_DLL_DECL ObjectGridLoader
 
         void Visit(DynamicObjectMapType&) { }
 
-        void LoadN(void);
+        // firstCell > 0 continue grid partly loaded by LoadCells
+        void LoadN(uint32 firstCell = 0);
+        // load cells [firstCell, lastCell) in LoadN order, used for grid loading in steps
+        void LoadCells(uint32 firstCell, uint32 lastCell);
 
     private:
         Cell i_cell;
@@ -22,7 +22,11 @@
 #include "Common.h"
 #include "ByteBuffer.h"
 
+#include <ace/Atomic_Op.h>
+
 #include <functional>
+#include <iterator>
+#include <cstddef>
 
 enum TypeID
 {
@@ -208,6 +212,143 @@ class MANGOS_DLL_SPEC ObjectGuid
 
 typedef std::set<ObjectGuid> ObjectGuidSet;
 
+/**
+ * Unordered set of not empty guids in one flat array (open addressing, linear probing).
+ *
+ * Used for often checked sets like Player::m_clientGUIDs: lookup touch mostly one cache line
+ * instead of walking std::set tree nodes. Any insert/erase invalidate iterators.
+ */
+class ObjectGuidHashSet
+{
+    public:
+        class const_iterator
+        {
+            public:
+                // for std algorithms and range insert into std containers
+                typedef std::forward_iterator_tag iterator_category;
+                typedef ObjectGuid value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef ObjectGuid const* pointer;
+                typedef ObjectGuid const& reference;
+
+                const_iterator() : m_itr(NULL), m_end(NULL) {}
+                const_iterator(ObjectGuid const* itr, ObjectGuid const* end) : m_itr(itr), m_end(end) { skipEmpty(); }
+
+                ObjectGuid const& operator*() const { return *m_itr; }
+                ObjectGuid const* operator->() const { return m_itr; }
+
+                const_iterator& operator++() { ++m_itr; skipEmpty(); return *this; }
+                const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+
+                bool operator==(const_iterator const& itr) const { return m_itr == itr.m_itr; }
+                bool operator!=(const_iterator const& itr) const { return m_itr != itr.m_itr; }
+
+            private:
+                void skipEmpty() { while (m_itr != m_end && m_itr->IsEmpty()) ++m_itr; }
+
+                ObjectGuid const* m_itr;
+                ObjectGuid const* m_end;
+        };
+
+        ObjectGuidHashSet() : m_size(0) {}
+
+        const_iterator begin() const { return m_slots.empty() ? const_iterator() : const_iterator(&m_slots[0], &m_slots[0] + m_slots.size()); }
+        const_iterator end() const { return m_slots.empty() ? const_iterator() : const_iterator(&m_slots[0] + m_slots.size(), &m_slots[0] + m_slots.size()); }
+
+        bool empty() const { return m_size == 0; }
+        size_t size() const { return m_size; }
+
+        size_t count(ObjectGuid const& guid) const
+        {
+            if (m_slots.empty())
+                return 0;
+
+            for (size_t i = slotFor(guid);; i = (i + 1) & (m_slots.size() - 1))
+            {
+                if (m_slots[i] == guid)
+                    return 1;
+                if (m_slots[i].IsEmpty())
+                    return 0;
+            }
+        }
+
+        // return false if guid already in set
+        bool insert(ObjectGuid const& guid)
+        {
+            MANGOS_ASSERT(!guid.IsEmpty());
+
+            // keep load factor <= 1/2 for short probe chains
+            if ((m_size + 1) * 2 > m_slots.size())
+                rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+
+            size_t i = slotFor(guid);
+            for (; !m_slots[i].IsEmpty(); i = (i + 1) & (m_slots.size() - 1))
+                if (m_slots[i] == guid)
+                    return false;
+
+            m_slots[i] = guid;
+            ++m_size;
+            return true;
+        }
+
+        // return false if guid not in set
+        bool erase(ObjectGuid const& guid)
+        {
+            if (m_slots.empty())
+                return false;
+
+            size_t mask = m_slots.size() - 1;
+            size_t i = slotFor(guid);
+            for (; m_slots[i] != guid; i = (i + 1) & mask)
+                if (m_slots[i].IsEmpty())
+                    return false;
+
+            // shift back following entries of probe chain instead of leaving deleted markers
+            for (size_t j = (i + 1) & mask; !m_slots[j].IsEmpty(); j = (j + 1) & mask)
+            {
+                size_t home = slotFor(m_slots[j]);
+                // entry at j can be moved to i only if its home slot is not in (i, j]
+                if (((j - home) & mask) >= ((j - i) & mask))
+                {
+                    m_slots[i] = m_slots[j];
+                    i = j;
+                }
+            }
+
+            m_slots[i] = ObjectGuid();
+            --m_size;
+            return true;
+        }
+
+        void clear()
+        {
+            m_slots.clear();
+            m_size = 0;
+        }
+
+    private:
+        size_t slotFor(ObjectGuid const& guid) const
+        {
+            // fibonacci hashing, guid counter bits are spread over whole table
+            uint64 hash = guid.GetRawValue() * UI64LIT(0x9E3779B97F4A7C15);
+            return size_t(hash >> 32) & (m_slots.size() - 1);
+        }
+
+        void rehash(size_t newSize)
+        {
+            std::vector<ObjectGuid> old(newSize);
+            old.swap(m_slots);
+            m_size = 0;
+
+            for (std::vector<ObjectGuid>::const_iterator itr = old.begin(); itr != old.end(); ++itr)
+                if (!itr->IsEmpty())
+                    insert(*itr);
+        }
+
+        std::vector<ObjectGuid> m_slots;                    // size is power of 2, empty guid mark free slot
+        size_t m_size;
+};
+
 //minimum buffer size for packed guid is 9 bytes
 #define PACKED_GUID_MIN_BUFFER_SIZE 9
 
@@ -242,10 +383,11 @@ class ObjectGuidGenerator
         uint32 Generate();
 
     public:                                                 // accessors
-        uint32 GetNextAfterMaxUsed() const { return m_nextGuid; }
+        uint32 GetNextAfterMaxUsed() const { return m_nextGuid.value(); }
 
     private:                                                // fields
-        uint32 m_nextGuid;
+        // global generators (items, corpses, groups...) used from map update threads
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> m_nextGuid;
 };
 
 ByteBuffer& operator<< (ByteBuffer& buf, ObjectGuid const& guid);
@@ -465,11 +465,9 @@ void ObjectMgr::LoadCreatureTemplates()
     std::set<uint32> hasDifficultyEntries[MAX_DIFFICULTY - 1]; // already loaded creatures with difficulty 1  values
 
     // check data correctness
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i)
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i);
-        if (!cInfo)
-            continue;
+        CreatureInfo const* cInfo = *itr;
 
         bool ok = true;                                     // bool to allow continue outside this loop
         for (uint32 diff = 0; diff < MAX_DIFFICULTY - 1 && ok; ++diff)
@@ -482,13 +480,13 @@ void ObjectMgr::LoadCreatureTemplates()
             if (!difficultyInfo)
             {
                 sLog.outErrorDb("Creature (Entry: %u) have `difficulty_entry_%u`=%u but creature entry %u not exist.",
-                    i, diff + 1, cInfo->DifficultyEntry[diff], cInfo->DifficultyEntry[diff]);
+                    cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff], cInfo->DifficultyEntry[diff]);
                 continue;
             }
 
-            if (difficultyEntries[diff].find(i) != difficultyEntries[diff].end())
+            if (difficultyEntries[diff].find(cInfo->Entry) != difficultyEntries[diff].end())
             {
-                sLog.outErrorDb("Creature (Entry: %u) listed as difficulty %u but have value in `difficulty_entry_%u`.", i, diff + 1, diff + 1);
+                sLog.outErrorDb("Creature (Entry: %u) listed as difficulty %u but have value in `difficulty_entry_%u`.", cInfo->Entry, diff + 1, diff + 1);
                 continue;
             }
 
@@ -505,7 +503,7 @@ void ObjectMgr::LoadCreatureTemplates()
                 if (hasDifficultyEntries[diff2].find(cInfo->DifficultyEntry[diff]) != hasDifficultyEntries[diff2].end())
                 {
                     sLog.outErrorDb("Creature (Entry: %u) have `difficulty_entry_%u`=%u but creature entry %u have difficulty %u entry also.",
-                        i, diff + 1, cInfo->DifficultyEntry[diff], cInfo->DifficultyEntry[diff], diff2 + 1);
+                        cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff], cInfo->DifficultyEntry[diff], diff2 + 1);
                     continue;
                 }
                 ok2 = true;
@@ -516,55 +514,55 @@ void ObjectMgr::LoadCreatureTemplates()
             if (cInfo->unit_class != difficultyInfo->unit_class)
             {
                 sLog.outErrorDb("Creature (Entry: %u, class %u) has different `unit_class` in difficulty %u mode (Entry: %u, class %u).",
-                    i, cInfo->unit_class, diff + 1, cInfo->DifficultyEntry[diff], difficultyInfo->unit_class);
+                    cInfo->Entry, cInfo->unit_class, diff + 1, cInfo->DifficultyEntry[diff], difficultyInfo->unit_class);
                 continue;
             }
 
             if (cInfo->npcflag != difficultyInfo->npcflag)
             {
-                sLog.outErrorDb("Creature (Entry: %u) has different `npcflag` in difficulty %u mode (Entry: %u).", i, diff + 1, cInfo->DifficultyEntry[diff]);
+                sLog.outErrorDb("Creature (Entry: %u) has different `npcflag` in difficulty %u mode (Entry: %u).", cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff]);
                 continue;
             }
 
             if (cInfo->trainer_class != difficultyInfo->trainer_class)
             {
-                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_class` in difficulty %u mode (Entry: %u).", i, diff + 1, cInfo->DifficultyEntry[diff]);
+                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_class` in difficulty %u mode (Entry: %u).", cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff]);
                 continue;
             }
 
             if (cInfo->trainer_race != difficultyInfo->trainer_race)
             {
-                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_race` in difficulty %u mode (Entry: %u).", i, diff + 1, cInfo->DifficultyEntry[diff]);
+                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_race` in difficulty %u mode (Entry: %u).", cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff]);
                 continue;
             }
 
             if (cInfo->trainer_type != difficultyInfo->trainer_type)
             {
-                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_type` in difficulty %u mode (Entry: %u).", i, diff + 1, cInfo->DifficultyEntry[diff]);
+                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_type` in difficulty %u mode (Entry: %u).", cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff]);
                 continue;
             }
 
             if (cInfo->trainer_spell != difficultyInfo->trainer_spell)
             {
-                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_spell` in difficulty %u mode (Entry: %u).", i, diff + 1, cInfo->DifficultyEntry[diff]);
+                sLog.outErrorDb("Creature (Entry: %u) has different `trainer_spell` in difficulty %u mode (Entry: %u).", cInfo->Entry, diff + 1, cInfo->DifficultyEntry[diff]);
                 continue;
             }
 
             if (difficultyInfo->AIName && *difficultyInfo->AIName)
             {
                 sLog.outErrorDb("Difficulty %u mode creature (Entry: %u) has `AIName`, but in any case will used difficulty 0 mode creature (Entry: %u) AIName.",
-                    diff + 1, cInfo->DifficultyEntry[diff], i);
+                    diff + 1, cInfo->DifficultyEntry[diff], cInfo->Entry);
                 continue;
             }
 
             if (difficultyInfo->ScriptID)
             {
                 sLog.outErrorDb("Difficulty %u mode creature (Entry: %u) has `ScriptName`, but in any case will used difficulty 0 mode creature (Entry: %u) ScriptName.",
-                    diff + 1, cInfo->DifficultyEntry[diff], i);
+                    diff + 1, cInfo->DifficultyEntry[diff], cInfo->Entry);
                 continue;
             }
 
-            hasDifficultyEntries[diff].insert(i);
+            hasDifficultyEntries[diff].insert(cInfo->Entry);
             difficultyEntries[diff].insert(cInfo->DifficultyEntry[diff]);
             ok = true;
         }
@@ -1181,8 +1179,11 @@ void ObjectMgr::LoadCreatureModelRace()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult *result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+
+    // prepared statement result rows come by binary protocol, without numeric values conversion from text
+    static SqlStatementID loadCreatures;
+    //                                                                       0                       1   2    3
+    SqlStatement stmt = WorldDatabase.CreateStatement(loadCreatures, "SELECT creature.guid, creature.id, map, modelid,"
     //   4             5           6           7           8            9              10         11
         "equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint,"
     //   12         13       14          15            16         17         18
@@ -1194,6 +1195,7 @@ void ObjectMgr::LoadCreatures()
         "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
         "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id");
 
+    QueryResult *result = stmt.Query();
     if (!result)
     {
         BarGoLink bar(1);
@@ -1207,11 +1209,10 @@ void ObjectMgr::LoadCreatures()
 
     // build single time for check creature data
     std::set<uint32> difficultyCreatures[MAX_DIFFICULTY - 1];
-    for (uint32 i = 0; i < sCreatureStorage.MaxEntry; ++i)
-        if (CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
-            for (uint32 diff = 0; diff < MAX_DIFFICULTY - 1; ++diff)
-                if (cInfo->DifficultyEntry[diff])
-                    difficultyCreatures[diff].insert(cInfo->DifficultyEntry[diff]);
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
+        for (uint32 diff = 0; diff < MAX_DIFFICULTY - 1; ++diff)
+            if (itr->DifficultyEntry[diff])
+                difficultyCreatures[diff].insert(itr->DifficultyEntry[diff]);
 
     // build single time for check spawnmask
     std::map<uint32,uint32> spawnMasks;
@@ -5892,11 +5893,9 @@ void ObjectMgr::LoadGameobjectInfo()
     loader.Load(sGOStorage);
 
     // some checks
-    for(uint32 id = 1; id < sGOStorage.MaxEntry; id++)
+    for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
     {
-        GameObjectInfo const* goInfo = sGOStorage.LookupEntry<GameObjectInfo>(id);
-        if (!goInfo)
-            continue;
+        GameObjectInfo const* goInfo = *itr;
 
 
         if (goInfo->size <= 0.0f)                           // prevent use too small scales
@@ -5963,7 +5962,7 @@ void ObjectMgr::LoadGameobjectInfo()
                 {
                     if (!sSpellFocusObjectStore.LookupEntry(goInfo->spellFocus.focusId))
                         sLog.outErrorDb("Gameobject (Entry: %u GoType: %u) have data0=%u but SpellFocus (Id: %u) not exist.",
-                            id,goInfo->type,goInfo->spellFocus.focusId,goInfo->spellFocus.focusId);
+                            goInfo->id,goInfo->type,goInfo->spellFocus.focusId,goInfo->spellFocus.focusId);
                 }
 
                 if (goInfo->spellFocus.linkedTrapId)        // linked trap
@@ -5981,7 +5980,7 @@ void ObjectMgr::LoadGameobjectInfo()
                 {
                     if (!sPageTextStore.LookupEntry<PageText>(goInfo->goober.pageId))
                         sLog.outErrorDb("Gameobject (Entry: %u GoType: %u) have data7=%u but PageText (Entry %u) not exist.",
-                            id,goInfo->type,goInfo->goober.pageId,goInfo->goober.pageId);
+                            goInfo->id,goInfo->type,goInfo->goober.pageId,goInfo->goober.pageId);
                 }
                 /* disable check for while, too many nonexistent spells
                 if (goInfo->goober.spellId)                 // spell
@@ -6010,7 +6009,7 @@ void ObjectMgr::LoadGameobjectInfo()
                 {
                     if (goInfo->moTransport.taxiPathId >= sTaxiPathNodesByPath.size() || sTaxiPathNodesByPath[goInfo->moTransport.taxiPathId].empty())
                         sLog.outErrorDb("Gameobject (Entry: %u GoType: %u) have data0=%u but TaxiPath (Id: %u) not exist.",
-                            id,goInfo->type,goInfo->moTransport.taxiPathId,goInfo->moTransport.taxiPathId);
+                            goInfo->id,goInfo->type,goInfo->moTransport.taxiPathId,goInfo->moTransport.taxiPathId);
                 }
                 break;
             }
@@ -8311,17 +8310,14 @@ void ObjectMgr::LoadTrainerTemplates()
     for(CacheTrainerSpellMap::const_iterator tItr = m_mCacheTrainerTemplateSpellMap.begin(); tItr != m_mCacheTrainerTemplateSpellMap.end(); ++tItr)
         trainer_ids.insert(tItr->first);
 
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i)
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        if (CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
+        if (itr->trainerId)
         {
-            if (cInfo->trainerId)
-            {
-                if (m_mCacheTrainerTemplateSpellMap.find(cInfo->trainerId) != m_mCacheTrainerTemplateSpellMap.end())
-                    trainer_ids.erase(cInfo->trainerId);
-                else
-                    sLog.outErrorDb("Creature (Entry: %u) has trainer_id = %u for nonexistent trainer template", cInfo->Entry, cInfo->trainerId);
-            }
+            if (m_mCacheTrainerTemplateSpellMap.find(itr->trainerId) != m_mCacheTrainerTemplateSpellMap.end())
+                trainer_ids.erase(itr->trainerId);
+            else
+                sLog.outErrorDb("Creature (Entry: %u) has trainer_id = %u for nonexistent trainer template", itr->Entry, itr->trainerId);
         }
     }
 
@@ -8392,17 +8388,14 @@ void ObjectMgr::LoadVendorTemplates()
     for(CacheVendorItemMap::const_iterator vItr = m_mCacheVendorTemplateItemMap.begin(); vItr != m_mCacheVendorTemplateItemMap.end(); ++vItr)
         vendor_ids.insert(vItr->first);
 
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i)
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        if (CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
+        if (itr->vendorId)
         {
-            if (cInfo->vendorId)
-            {
-                if (m_mCacheVendorTemplateItemMap.find(cInfo->vendorId) !=  m_mCacheVendorTemplateItemMap.end())
-                    vendor_ids.erase(cInfo->vendorId);
-                else
-                    sLog.outErrorDb("Creature (Entry: %u) has vendor_id = %u for nonexistent vendor template", cInfo->Entry, cInfo->vendorId);
-            }
+            if (m_mCacheVendorTemplateItemMap.find(itr->vendorId) !=  m_mCacheVendorTemplateItemMap.end())
+                vendor_ids.erase(itr->vendorId);
+            else
+                sLog.outErrorDb("Creature (Entry: %u) has vendor_id = %u for nonexistent vendor template", itr->Entry, itr->vendorId);
         }
     }
 
@@ -8534,17 +8527,15 @@ void ObjectMgr::LoadGossipMenu()
     sLog.outString( ">> Loaded %u gossip_menu entries", count);
 
     // post loading tests
-    for(uint32 i = 1; i < sCreatureStorage.MaxEntry; ++i)
-        if (CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
-            if (cInfo->GossipMenuId)
-                if (m_mGossipMenusMap.find(cInfo->GossipMenuId) == m_mGossipMenusMap.end())
-                    sLog.outErrorDb("Creature (Entry: %u) has gossip_menu_id = %u for nonexistent menu", cInfo->Entry, cInfo->GossipMenuId);
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
+        if (itr->GossipMenuId)
+            if (m_mGossipMenusMap.find(itr->GossipMenuId) == m_mGossipMenusMap.end())
+                sLog.outErrorDb("Creature (Entry: %u) has gossip_menu_id = %u for nonexistent menu", itr->Entry, itr->GossipMenuId);
 
-    for(uint32 i = 1; i < sGOStorage.MaxEntry; ++i)
-        if (GameObjectInfo const* gInfo = sGOStorage.LookupEntry<GameObjectInfo>(i))
-            if (uint32 menuid = gInfo->GetGossipMenuId())
-                if (m_mGossipMenusMap.find(menuid) == m_mGossipMenusMap.end())
-                    ERROR_DB_STRICT_LOG("Gameobject (Entry: %u) has gossip_menu_id = %u for nonexistent menu", gInfo->id, menuid);
+    for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
+        if (uint32 menuid = itr->GetGossipMenuId())
+            if (m_mGossipMenusMap.find(menuid) == m_mGossipMenusMap.end())
+                ERROR_DB_STRICT_LOG("Gameobject (Entry: %u) has gossip_menu_id = %u for nonexistent menu", itr->id, menuid);
 }
 
 void ObjectMgr::LoadGossipMenuItems()
@@ -8578,10 +8569,9 @@ void ObjectMgr::LoadGossipMenuItems()
             if (itr->first)
                 menu_ids.insert(itr->first);
 
-        for(uint32 i = 1; i < sGOStorage.MaxEntry; ++i)
-            if (GameObjectInfo const* gInfo = sGOStorage.LookupEntry<GameObjectInfo>(i))
-                if (uint32 menuid = gInfo->GetGossipMenuId())
-                    menu_ids.erase(menuid);
+        for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
+            if (uint32 menuid = itr->GetGossipMenuId())
+                menu_ids.erase(menuid);
     }
 
     // loading
@@ -8597,10 +8587,9 @@ void ObjectMgr::LoadGossipMenuItems()
     // prepare menuid -> CreatureInfo map for fast access
     typedef  std::multimap<uint32, const CreatureInfo*> Menu2CInfoMap;
     Menu2CInfoMap menu2CInfoMap;
-    for(uint32 i = 1;  i < sCreatureStorage.MaxEntry; ++i)
-        if (CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i))
-            if (cInfo->GossipMenuId)
-                menu2CInfoMap.insert(Menu2CInfoMap::value_type(cInfo->GossipMenuId, cInfo));
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
+        if (itr->GossipMenuId)
+            menu2CInfoMap.insert(Menu2CInfoMap::value_type(itr->GossipMenuId, *itr));
 
     do
     {
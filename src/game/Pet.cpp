@@ -58,7 +58,7 @@ void Pet::AddToWorld()
 {
     ///- Register the pet for guid lookup
     if(!IsInWorld())
-        GetMap()->GetObjectsStore().insert<Pet>(GetObjectGuid(), (Pet*)this);
+        GetMap()->InsertObject<Pet>(GetObjectGuid(), this);
 
     Unit::AddToWorld();
 }
@@ -67,7 +67,7 @@ void Pet::RemoveFromWorld()
 {
     ///- Remove the pet from the accessor
     if(IsInWorld())
-        GetMap()->GetObjectsStore().erase<Pet>(GetObjectGuid(), (Pet*)NULL);
+        GetMap()->EraseObject<Pet>(GetObjectGuid());
 
     ///- Don't call the function for Creature, normal mobs + totems go in a different storage
     Unit::RemoveFromWorld();
@@ -372,8 +372,8 @@ void Pet::SavePetToDB(PetSaveMode mode)
         if (mode != PET_SAVE_AS_CURRENT)
             RemoveAllAuras();
 
-        //save pet's data as one single transaction
-        CharacterDatabase.BeginTransaction();
+        //save pet's data as one single transaction, ordered with owner saves
+        CharacterDatabase.BeginTransaction(GetOwnerGuid().GetCounter());
         _SaveSpells();
         _SaveSpellCooldowns();
         _SaveAuras();
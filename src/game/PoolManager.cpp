@@ -1128,6 +1128,14 @@ void PoolManager::SetExcludeObject<GameObject>(uint16 pool_id, uint32 db_guid_or
 template<typename T>
 void PoolManager::UpdatePool(MapPersistentState& mapState, uint16 pool_id, uint32 db_guid_or_pool_id)
 {
+    // pooled objects can be in other region of parallel cell update, spawned state is shared too
+    Map* map = mapState.GetMap();
+    if (map && map->IsCellRegionsUpdateInProgress())
+    {
+        map->AddDelayedPoolUpdate(&PoolManager::UpdatePool<T>, pool_id, db_guid_or_pool_id);
+        return;
+    }
+
     if (uint16 motherpoolid = IsPartOfAPool<Pool>(pool_id))
         SpawnPoolGroup<Pool>(mapState, motherpoolid, pool_id, false);
     else
@@ -674,24 +674,23 @@ void ScriptMgr::LoadEventScripts()
     std::set<uint32> evt_scripts;
 
     // Load all possible script entries from gameobjects
-    for(uint32 i = 1; i < sGOStorage.MaxEntry; ++i)
+    for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
     {
-        if (GameObjectInfo const* goInfo = sGOStorage.LookupEntry<GameObjectInfo>(i))
-        {
-            if (uint32 eventId = goInfo->GetEventScriptId())
-                evt_scripts.insert(eventId);
+        GameObjectInfo const* goInfo = *itr;
 
-            if (goInfo->type == GAMEOBJECT_TYPE_CAPTURE_POINT)
-            {
-                evt_scripts.insert(goInfo->capturePoint.neutralEventID1);
-                evt_scripts.insert(goInfo->capturePoint.neutralEventID2);
-                evt_scripts.insert(goInfo->capturePoint.contestedEventID1);
-                evt_scripts.insert(goInfo->capturePoint.contestedEventID2);
-                evt_scripts.insert(goInfo->capturePoint.progressEventID1);
-                evt_scripts.insert(goInfo->capturePoint.progressEventID2);
-                evt_scripts.insert(goInfo->capturePoint.winEventID1);
-                evt_scripts.insert(goInfo->capturePoint.winEventID2);
-            }
+        if (uint32 eventId = goInfo->GetEventScriptId())
+            evt_scripts.insert(eventId);
+
+        if (goInfo->type == GAMEOBJECT_TYPE_CAPTURE_POINT)
+        {
+            evt_scripts.insert(goInfo->capturePoint.neutralEventID1);
+            evt_scripts.insert(goInfo->capturePoint.neutralEventID2);
+            evt_scripts.insert(goInfo->capturePoint.contestedEventID1);
+            evt_scripts.insert(goInfo->capturePoint.contestedEventID2);
+            evt_scripts.insert(goInfo->capturePoint.progressEventID1);
+            evt_scripts.insert(goInfo->capturePoint.progressEventID2);
+            evt_scripts.insert(goInfo->capturePoint.winEventID1);
+            evt_scripts.insert(goInfo->capturePoint.winEventID2);
         }
     }
 
@@ -862,24 +861,23 @@ void ScriptMgr::LoadEventIdScripts()
     std::set<uint32> evt_scripts;
 
     // Load all possible event entries from gameobjects
-    for (uint32 i = 1; i < sGOStorage.MaxEntry; ++i)
+    for (SQLStorage::const_iterator<GameObjectInfo> itr = sGOStorage.begin<GameObjectInfo>(); itr != sGOStorage.end<GameObjectInfo>(); ++itr)
     {
-        if (GameObjectInfo const* goInfo = sGOStorage.LookupEntry<GameObjectInfo>(i))
-        {
-            if (uint32 eventId = goInfo->GetEventScriptId())
-                evt_scripts.insert(eventId);
+        GameObjectInfo const* goInfo = *itr;
 
-            if (goInfo->type == GAMEOBJECT_TYPE_CAPTURE_POINT)
-            {
-                evt_scripts.insert(goInfo->capturePoint.neutralEventID1);
-                evt_scripts.insert(goInfo->capturePoint.neutralEventID2);
-                evt_scripts.insert(goInfo->capturePoint.contestedEventID1);
-                evt_scripts.insert(goInfo->capturePoint.contestedEventID2);
-                evt_scripts.insert(goInfo->capturePoint.progressEventID1);
-                evt_scripts.insert(goInfo->capturePoint.progressEventID2);
-                evt_scripts.insert(goInfo->capturePoint.winEventID1);
-                evt_scripts.insert(goInfo->capturePoint.winEventID2);
-            }
+        if (uint32 eventId = goInfo->GetEventScriptId())
+            evt_scripts.insert(eventId);
+
+        if (goInfo->type == GAMEOBJECT_TYPE_CAPTURE_POINT)
+        {
+            evt_scripts.insert(goInfo->capturePoint.neutralEventID1);
+            evt_scripts.insert(goInfo->capturePoint.neutralEventID2);
+            evt_scripts.insert(goInfo->capturePoint.contestedEventID1);
+            evt_scripts.insert(goInfo->capturePoint.contestedEventID2);
+            evt_scripts.insert(goInfo->capturePoint.progressEventID1);
+            evt_scripts.insert(goInfo->capturePoint.progressEventID2);
+            evt_scripts.insert(goInfo->capturePoint.winEventID1);
+            evt_scripts.insert(goInfo->capturePoint.winEventID2);
         }
     }
 
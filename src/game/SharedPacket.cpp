@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SharedPacket.h"
+#include "WorldPacket.h"
+
+PacketBuffer::PacketBuffer(size_t capacity) : m_refs(1), m_data(new uint8[capacity ? capacity : 1]), m_size(0), m_capacity(capacity)
+{
+}
+
+PacketBuffer* PacketBuffer::Create(WorldPacket const& packet)
+{
+    PacketBuffer* buffer = new PacketBuffer(packet.size());
+    if (!packet.empty())
+        buffer->Append(packet.contents(), packet.size());
+    return buffer;
+}
+
+PacketBuffer* PacketBuffer::Create(size_t capacity)
+{
+    return new PacketBuffer(capacity);
+}
+
+void PacketBuffer::Append(uint8 const* data, size_t size)
+{
+    MANGOS_ASSERT(!IsShared() && size <= GetSpace());
+
+    memcpy(m_data + m_size, data, size);
+    m_size += size;
+}
+
+PacketBuffer* SharedPacket::GetBuffer()
+{
+    if (!m_buffer)
+        m_buffer = PacketBuffer::Create(m_packet);
+
+    return m_buffer;
+}
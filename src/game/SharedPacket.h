@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SHAREDPACKET_H
+#define MANGOS_SHAREDPACKET_H
+
+#include "Common.h"
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+class WorldPacket;
+
+/**
+ * Packet data with thread safe reference counter.
+ *
+ * WorldSocket output queue keep references to such buffers instead of own packet copies,
+ * so packet sent to many players is copied only once. Buffer shared between sockets
+ * is never modified, socket only append data to own (not shared) buffers.
+ */
+class PacketBuffer
+{
+    public:
+        // create buffer with copy of packet body, caller own one reference
+        static PacketBuffer* Create(WorldPacket const& packet);
+        // create empty buffer for later Append, caller own one reference
+        static PacketBuffer* Create(size_t capacity);
+
+        void AddReference() { ++m_refs; }
+        void RemoveReference() { if (--m_refs == 0) delete this; }
+        bool IsShared() const { return m_refs.value() > 1; }
+
+        uint8 const* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+        size_t GetSpace() const { return m_capacity - m_size; }
+
+        // only for not shared buffer with enough space
+        void Append(uint8 const* data, size_t size);
+
+    private:
+        explicit PacketBuffer(size_t capacity);
+        ~PacketBuffer() { delete[] m_data; }
+
+        PacketBuffer(PacketBuffer const&);
+        PacketBuffer& operator=(PacketBuffer const&);
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_refs;
+        uint8* m_data;
+        size_t m_size;
+        size_t m_capacity;
+};
+
+/**
+ * Packet prepared for sending to many sessions (message deliverers, map object updates).
+ *
+ * Body copied into PacketBuffer at first socket that need it, other sockets only reference it.
+ * Object expected to be used by one thread and live while packet delivered.
+ */
+class SharedPacket
+{
+    public:
+        explicit SharedPacket(WorldPacket const& packet) : m_packet(packet), m_buffer(NULL) {}
+        ~SharedPacket() { if (m_buffer) m_buffer->RemoveReference(); }
+
+        WorldPacket const& GetPacket() const { return m_packet; }
+
+        // buffer with packet body, owned by SharedPacket (receiver must add own reference)
+        PacketBuffer* GetBuffer();
+
+    private:
+        SharedPacket(SharedPacket const&);
+        SharedPacket& operator=(SharedPacket const&);
+
+        WorldPacket const& m_packet;
+        PacketBuffer* m_buffer;
+};
+
+#endif
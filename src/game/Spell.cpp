@@ -657,9 +657,12 @@ void Spell::FillTargetMap()
             }
         }
 
+        // for multiple targets LOS is checked in batches after all other target checks
+        bool batchLOS = tmpUnitMap.size() > 1 && HasDefaultTargetLOSCheck(SpellEffectIndex(i));
+
         for (UnitList::iterator itr = tmpUnitMap.begin(); itr != tmpUnitMap.end();)
         {
-            if (!CheckTarget (*itr, SpellEffectIndex(i)))
+            if (!CheckTarget (*itr, SpellEffectIndex(i), !batchLOS))
             {
                 itr = tmpUnitMap.erase(itr);
                 continue;
@@ -668,6 +671,10 @@ void Spell::FillTargetMap()
                 ++itr;
         }
 
+        if (batchLOS)
+            if (WorldObject* caster = GetCastingObject())
+                FilterTargetsInLOS(tmpUnitMap, caster);
+
         for(UnitList::const_iterator iunit = tmpUnitMap.begin(); iunit != tmpUnitMap.end(); ++iunit)
             AddUnitTarget((*iunit), SpellEffectIndex(i));
     }
@@ -6769,7 +6776,7 @@ CurrentSpellTypes Spell::GetCurrentContainer()
         return(CURRENT_GENERIC_SPELL);
 }
 
-bool Spell::CheckTarget( Unit* target, SpellEffectIndex eff )
+bool Spell::CheckTarget( Unit* target, SpellEffectIndex eff, bool checkLOS /*= true*/ )
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
     if(m_spellInfo->EffectImplicitTargetA[eff] != TARGET_SELF )
@@ -6846,7 +6853,7 @@ bool Spell::CheckTarget( Unit* target, SpellEffectIndex eff )
             break;
         default:                                            // normal case
             // Get GO cast coordinates if original caster -> GO
-            if (target != m_caster)
+            if (checkLOS && target != m_caster)
                 if (WorldObject *caster = GetCastingObject())
                     if (!target->IsWithinLOSInMap(caster))
                         return false;
@@ -6864,6 +6871,79 @@ bool Spell::CheckTarget( Unit* target, SpellEffectIndex eff )
     return true;
 }
 
+bool Spell::HasDefaultTargetLOSCheck(SpellEffectIndex eff) const
+{
+    // must be in sync with special cases of LOS check in CheckTarget
+    switch(m_spellInfo->Effect[eff])
+    {
+        case SPELL_EFFECT_SUMMON_PLAYER:
+        case SPELL_EFFECT_DUMMY:
+        case SPELL_EFFECT_RESURRECT_NEW:
+            return false;
+        default:
+            return true;
+    }
+}
+
+void Spell::FilterTargetsInLOS(UnitList &targetUnitMap, WorldObject* caster)
+{
+    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
+
+    float ox, oy, oz;
+    caster->GetPosition(ox, oy, oz);
+
+    // same rays as in WorldObject::IsWithinLOSInMap (target -> caster), but tested VMAP_MAX_LOS_BATCH at once
+    float coords[VMAP_MAX_LOS_BATCH * 6];
+    Unit* batch[VMAP_MAX_LOS_BATCH];
+
+    UnitList::iterator itr = targetUnitMap.begin();
+    while (itr != targetUnitMap.end())
+    {
+        uint32 count = 0;
+        UnitList::iterator batchStart = itr;
+        for (; itr != targetUnitMap.end() && count < VMAP_MAX_LOS_BATCH; ++itr)
+        {
+            Unit* target = *itr;
+            if (target == m_caster || !target->IsInMap(caster))
+                continue;
+
+            float* ray = &coords[count * 6];
+            target->GetPosition(ray[0], ray[1], ray[2]);
+            ray[2] += 2.0f;
+            ray[3] = ox;
+            ray[4] = oy;
+            ray[5] = oz + 2.0f;
+            batch[count++] = target;
+        }
+
+        uint32 visible = count ? vMapManager->isInLineOfSight(caster->GetMapId(), coords, count) : 0;
+
+        // walk batch range again, targets in batch are in same order as in list
+        uint32 idx = 0;
+        for (UnitList::iterator bItr = batchStart; bItr != itr;)
+        {
+            Unit* target = *bItr;
+            if (target == m_caster)
+            {
+                ++bItr;
+                continue;
+            }
+
+            if (idx < count && batch[idx] == target)
+            {
+                if (visible & (uint32(1) << idx++))
+                {
+                    ++bItr;
+                    continue;
+                }
+            }
+
+            // not in caster map or LOS blocked
+            bItr = targetUnitMap.erase(bItr);
+        }
+    }
+}
+
 bool Spell::IsNeedSendToClient() const
 {
     return m_spellInfo->SpellVisual[0] || m_spellInfo->SpellVisual[1] || IsChanneledSpell(m_spellInfo) ||
@@ -7089,7 +7169,12 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
 void Spell::FillAreaTargets(UnitList &targetUnitMap, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=NULL*/)
 {
     MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
+
+    // prefilter by cell position indexes, exact checks done by notifier
+    CellPositionUnitList units;
+    m_caster->GetMap()->SelectUnitsInRange(notifier.GetCenterX(), notifier.GetCenterY(), radius, notifier.GetCenterBoundingRadius(), CELL_POSITION_ALL_OBJECTS, units);
+    for(CellPositionUnitList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        notifier.VisitTarget(*itr);
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList &targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster)
@@ -414,7 +414,9 @@ class Spell
 
         template<typename T> WorldObject* FindCorpseUsing();
 
-        bool CheckTarget( Unit* target, SpellEffectIndex eff );
+        bool CheckTarget( Unit* target, SpellEffectIndex eff, bool checkLOS = true );
+        bool HasDefaultTargetLOSCheck(SpellEffectIndex eff) const;
+        void FilterTargetsInLOS(UnitList &targetUnitMap, WorldObject* caster);
         bool CanAutoCast(Unit* target);
 
         static void MANGOS_DLL_SPEC SendCastResult(Player* caster, SpellEntry const* spellInfo, uint8 cast_count, SpellCastResult result);
@@ -707,14 +709,16 @@ namespace MaNGOS
         bool i_playerControlled;
         float i_centerX;
         float i_centerY;
+        float i_centerBoundingRadius;                       // added to radius in distance checks from center object
 
         float GetCenterX() const { return i_centerX; }
         float GetCenterY() const { return i_centerY; }
+        float GetCenterBoundingRadius() const { return i_centerBoundingRadius; }
 
         SpellNotifierCreatureAndPlayer(Spell &spell, Spell::UnitList &data, float radius, SpellNotifyPushType type,
             SpellTargets TargetType = SPELL_TARGETS_NOT_FRIENDLY, WorldObject* originalCaster = NULL)
             : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
-            i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+            i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject()), i_centerBoundingRadius(0.0f)
         {
             if (!i_originalCaster)
                 i_originalCaster = i_spell.GetAffectiveCasterObject();
@@ -732,6 +736,7 @@ namespace MaNGOS
                     {
                         i_centerX = i_castingObject->GetPositionX();
                         i_centerY = i_castingObject->GetPositionY();
+                        i_centerBoundingRadius = i_castingObject->GetObjectBoundingRadius();
                     }
                     break;
                 case PUSH_DEST_CENTER:
@@ -743,6 +748,7 @@ namespace MaNGOS
                     {
                         i_centerX = target->GetPositionX();
                         i_centerY = target->GetPositionY();
+                        i_centerBoundingRadius = target->GetObjectBoundingRadius();
                     }
                     break;
                 default:
@@ -751,97 +757,101 @@ namespace MaNGOS
         }
 
         template<class T> inline void Visit(GridRefManager<T>  &m)
+        {
+            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                VisitTarget(itr->getSource());
+        }
+
+        // also used directly for candidates selected by Map::SelectUnitsInRange
+        void VisitTarget(Unit* target)
         {
             MANGOS_ASSERT(i_data);
 
             if (!i_originalCaster || !i_castingObject)
                 return;
 
-            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                if ( (i_TargetType != SPELL_TARGETS_ALL && !itr->getSource()->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
-                    // mostly phase check
-                    || !itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            if ( (i_TargetType != SPELL_TARGETS_ALL && !target->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
+                // mostly phase check
+                || !target->IsInMap(i_originalCaster))
+                return;
 
-                switch (i_TargetType)
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_HOSTILE:
+                    if (!i_originalCaster->IsHostileTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_FRIENDLY:
+                    if (i_originalCaster->IsFriendlyTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_HOSTILE:
+                    if (i_originalCaster->IsHostileTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_FRIENDLY:
+                    if (!i_originalCaster->IsFriendlyTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_AOE_DAMAGE:
                 {
-                    case SPELL_TARGETS_HOSTILE:
-                        if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_FRIENDLY:
-                        if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_HOSTILE:
-                        if (i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_FRIENDLY:
-                        if (!i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_DAMAGE:
+                    if (target->GetTypeId()==TYPEID_UNIT && ((Creature*)target)->IsTotem())
+                        return;
+
+                    if (i_playerControlled)
                     {
-                        if (itr->getSource()->GetTypeId()==TYPEID_UNIT && ((Creature*)itr->getSource())->IsTotem())
-                            continue;
-
-                        if (i_playerControlled)
-                        {
-                            if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                                continue;
-                        }
+                        if (i_originalCaster->IsFriendlyTo( target ))
+                            return;
+                    }
+                    else
+                    {
+                        if (!i_originalCaster->IsHostileTo( target ))
+                            return;
                     }
-                    break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch(i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/2 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_30:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/6 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/12 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_castingObject->isInBack((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if (i_castingObject->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if (itr->getSource()->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                }
+            // we don't need to check InMap here, it's already done some lines above
+            switch(i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_castingObject->isInFront(target, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if (i_castingObject->isInFront(target, i_radius, M_PI_F/2 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_30:
+                    if (i_castingObject->isInFront(target, i_radius, M_PI_F/6 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if (i_castingObject->isInFront(target, i_radius, M_PI_F/12 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_BACK:
+                    if (i_castingObject->isInBack(target, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_SELF_CENTER:
+                    if (i_castingObject->IsWithinDist(target, i_radius))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_DEST_CENTER:
+                    if (target->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist(target, i_radius))
+                        i_data->push_back(target);
+                    break;
             }
         }
 
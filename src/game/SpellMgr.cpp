@@ -3487,11 +3487,9 @@ void SpellMgr::LoadPetDefaultSpells()
     uint32 countCreature = 0;
     uint32 countData = 0;
 
-    for(uint32 i = 0; i < sCreatureStorage.MaxEntry; ++i )
+    for (SQLStorage::const_iterator<CreatureInfo> itr = sCreatureStorage.begin<CreatureInfo>(); itr != sCreatureStorage.end<CreatureInfo>(); ++itr)
     {
-        CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(i);
-        if(!cInfo)
-            continue;
+        CreatureInfo const* cInfo = *itr;
 
         if(!cInfo->PetSpellDataId)
             continue;
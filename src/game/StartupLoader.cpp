@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "StartupLoader.h"
+#include "Log.h"
+#include "Timer.h"
+#include "ProgressBar.h"
+
+class StartupLoadRequest : public MapUpdater::Request
+{
+    public:
+        explicit StartupLoadRequest(StartupLoader::Task& task) : m_task(task) {}
+
+        void call()
+        {
+            m_task.m_loader.Execute(m_task);
+            m_task.m_loader.Complete(m_task);
+        }
+
+    private:
+        StartupLoader::Task& m_task;
+};
+
+StartupLoader::Task::Task(StartupLoader& loader, char const* name, char const* title, MaNGOS::ICallback* callback) :
+    m_loader(loader), m_name(name), m_title(title), m_callback(callback), m_dependencies(0), m_waiting(0), m_time(0)
+{
+}
+
+StartupLoader::Task::~Task()
+{
+    delete m_callback;
+}
+
+StartupLoader::Task& StartupLoader::Task::After(char const* name)
+{
+    Task* task = m_loader.FindTask(name);
+
+    // dependency must be registered before, this also prevent dependency cycles
+    MANGOS_ASSERT(task && task != this);
+
+    task->m_dependents.push_back(this);
+    ++m_dependencies;
+    return *this;
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (TaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        delete *itr;
+}
+
+StartupLoader::Task& StartupLoader::AddTask(char const* name, char const* title, MaNGOS::ICallback* callback)
+{
+    MANGOS_ASSERT(!FindTask(name));
+
+    Task* task = new Task(*this, name, title, callback);
+    m_tasks.push_back(task);
+    return *task;
+}
+
+StartupLoader::Task* StartupLoader::FindTask(char const* name) const
+{
+    for (TaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        if (strcmp((*itr)->m_name, name) == 0)
+            return *itr;
+
+    return NULL;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (threads <= 1)
+    {
+        for (TaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+            Execute(**itr);
+    }
+    else
+    {
+        // progress bars of concurrently running loaders would overwrite each other in console
+        bool showProgress = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        MapUpdater pool;
+        MapUpdater::Batch batch;
+
+        m_pool = &pool;
+        m_batch = &batch;
+
+        for (TaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+            (*itr)->m_waiting = (*itr)->m_dependencies;
+
+        // caller thread also executes tasks while waiting for the batch
+        pool.Activate(threads - 1);
+
+        for (TaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+            if (!(*itr)->m_dependencies)
+                pool.Schedule(new StartupLoadRequest(**itr), &batch);
+
+        pool.Wait(batch);
+        pool.Deactivate();
+
+        m_pool = NULL;
+        m_batch = NULL;
+
+        BarGoLink::SetOutputState(showProgress);
+    }
+
+    uint32 totalTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    sLog.outString();
+    sLog.outString("Startup loaders wall time (%u threads):", threads > 1 ? threads : 1);
+    for (TaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        sLog.outString("    %-32s %7u ms", (*itr)->m_name, (*itr)->m_time);
+    sLog.outString(">>> %u loaders done in %u ms", uint32(m_tasks.size()), totalTime);
+    sLog.outString();
+}
+
+void StartupLoader::Execute(Task& task)
+{
+    if (task.m_title)
+        sLog.outString("%s", task.m_title);
+
+    uint32 startTime = WorldTimer::getMSTime();
+    task.m_callback->Execute();
+    task.m_time = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+void StartupLoader::Complete(Task& task)
+{
+    Task::TaskList ready;
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+        for (Task::TaskList::const_iterator itr = task.m_dependents.begin(); itr != task.m_dependents.end(); ++itr)
+        {
+            MANGOS_ASSERT((*itr)->m_waiting > 0);
+            if (--(*itr)->m_waiting == 0)
+                ready.push_back(*itr);
+        }
+    }
+
+    // scheduled before this request is finished, so the batch can't be seen as done meanwhile
+    for (Task::TaskList::const_iterator itr = ready.begin(); itr != ready.end(); ++itr)
+        m_pool->Schedule(new StartupLoadRequest(**itr), m_batch);
+}
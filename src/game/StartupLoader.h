@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_STARTUPLOADER_H
+#define MANGOS_STARTUPLOADER_H
+
+#include "Common.h"
+#include "Utilities/Callback.h"
+#include "MapUpdater.h"
+#include <ace/Thread_Mutex.h>
+
+/**
+ * Runs static data loaders of world startup as a dependency graph.
+ *
+ * Every loader is registered with the names of loaders it must run after, so "must be after"
+ * rules of World::SetInitialWorldSettings are explicit. Dependencies must be registered before
+ * the dependent loader, so registration order is always a valid execution order.
+ *
+ * With 0 or 1 threads loaders are executed one by one in registration order in caller thread.
+ * Otherwise every loader with finished dependencies is executed by a pool of worker threads, sync
+ * queries of different threads are spread over WorldDatabaseConnections and CharacterDatabaseConnections
+ * connection pools.
+ *
+ * Loaders that modify the same shared data (map object guid cells, condition list, locale indexes,
+ * quest flags) must be chained by dependency even when they don't use results of each other.
+ */
+class StartupLoader
+{
+    public:
+        class Task
+        {
+            public:
+                // task must run after already registered task with name
+                Task& After(char const* name);
+
+            private:
+                friend class StartupLoader;
+                friend class StartupLoadRequest;
+
+                Task(StartupLoader& loader, char const* name, char const* title, MaNGOS::ICallback* callback);
+                ~Task();
+
+                typedef std::vector<Task*> TaskList;
+
+                StartupLoader& m_loader;
+                char const* m_name;
+                char const* m_title;
+                MaNGOS::ICallback* m_callback;
+
+                TaskList m_dependents;
+                uint32 m_dependencies;                      // total count of tasks this task must run after
+                uint32 m_waiting;                           // not finished dependencies at run
+                uint32 m_time;                              // wall time of loader in ms
+        };
+
+        StartupLoader() : m_pool(NULL), m_batch(NULL) {}
+        ~StartupLoader();
+
+        // title is logged before loader start, NULL for loaders that log own title
+        Task& Add(char const* name, char const* title, void (*function)())
+        {
+            return AddTask(name, title, new MaNGOS::_ICallback<MaNGOS::_SCallback<> >(MaNGOS::_SCallback<>(function)));
+        }
+
+        template<class Class>
+        Task& Add(char const* name, char const* title, Class& object, void (Class::*method)())
+        {
+            return AddTask(name, title, new MaNGOS::Callback<Class>(&object, method));
+        }
+
+        // execute all registered tasks and log wall time of every loader
+        void Run(uint32 threads);
+
+    private:
+        friend class StartupLoadRequest;
+
+        Task& AddTask(char const* name, char const* title, MaNGOS::ICallback* callback);
+        Task* FindTask(char const* name) const;
+
+        void Execute(Task& task);
+        // called by worker after task execution, schedule dependents that have no more waiting dependencies
+        void Complete(Task& task);
+
+        typedef std::vector<Task*> TaskList;
+        TaskList m_tasks;
+
+        ACE_Thread_Mutex m_lock;                            // guard m_waiting counters at parallel run
+        MapUpdater* m_pool;
+        MapUpdater::Batch* m_batch;
+};
+
+#endif
@@ -64,6 +64,7 @@ HostileReference::HostileReference(Unit* pUnit, ThreatManager *pThreatManager, f
     iUnitGuid = pUnit->GetObjectGuid();
     iOnline = true;
     iAccessible = true;
+    iHeapIndex = 0;
 }
 
 //============================================================
@@ -210,12 +211,147 @@ Unit* HostileReference::getSourceUnit()
 
 void ThreatContainer::clearReferences()
 {
-    for(ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for(ThreatList::const_iterator i = iThreatHeap.begin(); i != iThreatHeap.end(); ++i)
     {
         (*i)->unlink();
         delete (*i);
     }
+    iThreatHeap.clear();
     iThreatList.clear();
+    iDirty = false;
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
+{
+    pHostileReference->iHeapIndex = iThreatHeap.size();
+    iThreatHeap.push_back(pHostileReference);
+    siftUp(pHostileReference->iHeapIndex);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    uint32 index = pRef->iHeapIndex;
+    MANGOS_ASSERT(index < iThreatHeap.size() && iThreatHeap[index] == pRef);
+
+    uint32 last = iThreatHeap.size() - 1;
+    if (index != last)
+    {
+        HostileReference* moved = iThreatHeap[last];
+        swapReferences(index, last);
+        iThreatHeap.pop_back();
+
+        // moved last reference can be out of order in any direction
+        siftUp(index);
+        siftDown(moved->iHeapIndex);
+    }
+    else
+        iThreatHeap.pop_back();
+
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::updateReference(HostileReference* pRef)
+{
+    uint32 index = pRef->iHeapIndex;
+    MANGOS_ASSERT(index < iThreatHeap.size() && iThreatHeap[index] == pRef);
+
+    siftUp(index);
+    siftDown(pRef->iHeapIndex);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::swapReferences(uint32 lhs, uint32 rhs)
+{
+    std::swap(iThreatHeap[lhs], iThreatHeap[rhs]);
+    iThreatHeap[lhs]->iHeapIndex = lhs;
+    iThreatHeap[rhs]->iHeapIndex = rhs;
+}
+
+void ThreatContainer::siftUp(uint32 index)
+{
+    while (index > 0)
+    {
+        uint32 parent = (index - 1) / 2;
+        if (!isHigher(index, parent))
+            break;
+
+        swapReferences(index, parent);
+        index = parent;
+    }
+}
+
+void ThreatContainer::siftDown(uint32 index)
+{
+    uint32 size = iThreatHeap.size();
+    for (;;)
+    {
+        uint32 highest = index;
+        uint32 left = 2 * index + 1;
+        uint32 right = left + 1;
+
+        if (left < size && isHigher(left, highest))
+            highest = left;
+        if (right < size && isHigher(right, highest))
+            highest = right;
+
+        if (highest == index)
+            break;
+
+        swapReferences(index, highest);
+        index = highest;
+    }
+}
+
+//============================================================
+
+void ThreatContainer::OrderedWalker::reset()
+{
+    iCandidates.clear();
+    if (!iContainer.iThreatHeap.empty())
+        iCandidates.push_back(0);
+}
+
+struct HeapIndexThreatLess
+{
+    explicit HeapIndexThreatLess(ThreatList const& heap) : i_heap(heap) {}
+
+    bool operator() (uint32 lhs, uint32 rhs) const { return i_heap[lhs]->getThreat() < i_heap[rhs]->getThreat(); }
+
+    ThreatList const& i_heap;
+};
+
+void ThreatContainer::OrderedWalker::addCandidate(uint32 index)
+{
+    if (index >= iContainer.iThreatHeap.size())
+        return;
+
+    iCandidates.push_back(index);
+    std::push_heap(iCandidates.begin(), iCandidates.end(), HeapIndexThreatLess(iContainer.iThreatHeap));
+}
+
+// next highest is always one from children of already returned references
+HostileReference* ThreatContainer::OrderedWalker::next()
+{
+    if (iCandidates.empty())
+        return NULL;
+
+    std::pop_heap(iCandidates.begin(), iCandidates.end(), HeapIndexThreatLess(iContainer.iThreatHeap));
+    uint32 index = iCandidates.back();
+    iCandidates.pop_back();
+
+    addCandidate(2 * index + 1);
+    addCandidate(2 * index + 2);
+
+    return iContainer.iThreatHeap[index];
 }
 
 //============================================================
@@ -224,7 +360,7 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
 {
     HostileReference* result = NULL;
     ObjectGuid guid = pVictim->GetObjectGuid();
-    for(ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for(ThreatList::const_iterator i = iThreatHeap.begin(); i != iThreatHeap.end(); ++i)
     {
         if ((*i)->getUnitGuid() == guid)
         {
@@ -259,19 +395,22 @@ void ThreatContainer::modifyThreatPercent(Unit *pVictim, int32 pPercent)
 
 bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
 {
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
+    // std::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
     return lhs->getThreat() > rhs->getThreat();             // reverse sorting
 }
 
 //============================================================
 // Check if the list is dirty and sort if necessary
 
-void ThreatContainer::update()
+void ThreatContainer::update() const
 {
-    if(iDirty && iThreatList.size() >1)
-    {
-        iThreatList.sort(HostileReferenceSortPredicate);
-    }
+    if (!iDirty)
+        return;
+
+    iThreatList.assign(iThreatHeap.begin(), iThreatHeap.end());
+    if (iThreatList.size() > 1)
+        std::sort(iThreatList.begin(), iThreatList.end(), HostileReferenceSortPredicate);
+
     iDirty = false;
 }
 
@@ -281,36 +420,30 @@ void ThreatContainer::update()
 
 HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim)
 {
-    HostileReference* currentRef = NULL;
-    bool found = false;
     bool noPriorityTargetFound = false;
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    lastRef--;
-
-    for(ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    // references visited in threat order, in common case only first few are checked
+    OrderedWalker walker(*this);
+    while (HostileReference* currentRef = walker.next())
     {
-        currentRef = (*iter);
-
         Unit* target = currentRef->getTarget();
         MANGOS_ASSERT(target);                              // if the ref has status online the target must be there !
 
         // some units are prefered in comparison to others
         if(!noPriorityTargetFound && (target->IsImmunedToDamage(pAttacker->GetMeleeDamageSchoolMask()) || target->hasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_DAMAGE)) )
         {
-            if(iter != lastRef)
+            if (!walker.finished())
             {
                 // current victim is a second choice target, so don't compare threat with it below
                 if(currentRef == pCurrentVictim)
                     pCurrentVictim = NULL;
-                ++iter;
                 continue;
             }
             else
             {
                 // if we reached to this point, everyone in the threatlist is a second choice target. In such a situation the target with the highest threat should be attacked.
                 noPriorityTargetFound = true;
-                iter = iThreatList.begin();
+                walker.reset();
                 continue;
             }
         }
@@ -321,32 +454,21 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
             {
                 // list sorted and and we check current target, then this is best case
                 if(pCurrentVictim == currentRef || currentRef->getThreat() <= 1.1f * pCurrentVictim->getThreat() )
-                {
-                    currentRef = pCurrentVictim;            // for second case
-                    found = true;
-                    break;
-                }
+                    return pCurrentVictim;                  // for second case
 
                 if (currentRef->getThreat() > 1.3f * pCurrentVictim->getThreat() ||
                      (currentRef->getThreat() > 1.1f * pCurrentVictim->getThreat() &&
                      pAttacker->CanReachWithMeleeAttack(target)) )
                 {                                           //implement 110% threat rule for targets in melee range
-                    found = true;                           //and 130% rule for targets in ranged distances
-                    break;                                  //for selecting alive targets
-                }
+                    return currentRef;                      //and 130% rule for targets in ranged distances
+                }                                           //for selecting alive targets
             }
             else                                            // select any
-            {
-                found = true;
-                break;
-            }
+                return currentRef;
         }
-        ++iter;
     }
-    if(!found)
-        currentRef = NULL;
 
-    return currentRef;
+    return NULL;
 }
 
 //============================================================
@@ -447,7 +569,6 @@ void ThreatManager::modifyThreatPercent(Unit *pVictim, int32 pPercent)
 
 Unit* ThreatManager::getHostileTarget()
 {
-    iThreatContainer.update();
     HostileReference* nextVictim = iThreatContainer.selectNextVictim((Creature*) getOwner(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != NULL ? getCurrentVictim()->getTarget() : NULL;
@@ -523,18 +644,17 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch(threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed
+            if (hostileReference->isOnline())
+                iThreatContainer.updateReference(hostileReference);
+            else
+                iThreatOfflineContainer.updateReference(hostileReference);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if(!hostileReference->isOnline())
             {
                 if (hostileReference == getCurrentVictim())
-                {
                     setCurrentVictim(NULL);
-                    setDirty(true);
-                }
                 iOwner->SendThreatRemove(hostileReference);
                 iThreatContainer.remove(hostileReference);
                 iUpdateNeed = true;
@@ -542,19 +662,15 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             }
             else
             {
-                if(getCurrentVictim() && hostileReference->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
+                // heap index is shared, so remove from old container first
+                iThreatOfflineContainer.remove(hostileReference);
                 iThreatContainer.addReference(hostileReference);
                 iUpdateNeed = true;
-                iThreatOfflineContainer.remove(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
             if (hostileReference == getCurrentVictim())
-            {
                 setCurrentVictim(NULL);
-                setDirty(true);
-            }
             if(hostileReference->isOnline())
             {
                 iOwner->SendThreatRemove(hostileReference);
@@ -26,6 +26,7 @@
 #include "Timer.h"
 #include "ObjectGuid.h"
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -119,6 +120,8 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
         // Tell our refFrom (source) object, that the link is cut (Target destroyed)
         void sourceObjectDestroyLink();
     private:
+        friend class ThreatContainer;
+
         // Inform the source, that the status of that reference was changed
         void fireStatusChanged(ThreatRefStatusChangeEvent& pThreatRefStatusChangeEvent);
 
@@ -129,28 +132,55 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+        uint32 iHeapIndex;                                  // position in owner ThreatContainer heap
 };
 
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
-
+typedef std::vector<HostileReference*> ThreatList;
 
+// References kept as indexed binary max-heap by threat, threat changes sift the reference in place
+// Sorted list build only at request (scripts, threat list iteration), victim selection walk heap in order
 class MANGOS_DLL_SPEC ThreatContainer
 {
     private:
-        ThreatList iThreatList;
-        bool iDirty;
+        ThreatList iThreatHeap;
+        mutable ThreatList iThreatList;                     // sorted copy of heap, rebuilt when dirty
+        mutable bool iDirty;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
+        // restore heap order after reference threat change
+        void updateReference(HostileReference* pRef);
         void clearReferences();
         // Sort the list if necessary
-        void update();
+        void update() const;
+    private:
+        bool isHigher(uint32 lhs, uint32 rhs) const { return iThreatHeap[lhs]->getThreat() > iThreatHeap[rhs]->getThreat(); }
+        void swapReferences(uint32 lhs, uint32 rhs);
+        void siftUp(uint32 index);
+        void siftDown(uint32 index);
     public:
+        // visit references in threat descending order, O(log k) per step without sorting the container
+        class OrderedWalker
+        {
+            public:
+                explicit OrderedWalker(ThreatContainer const& container) : iContainer(container) { reset(); }
+
+                void reset();
+                HostileReference* next();
+                // no references left after last returned by next()
+                bool finished() const { return iCandidates.empty(); }
+            private:
+                void addCandidate(uint32 index);
+
+                ThreatContainer const& iContainer;
+                std::vector<uint32> iCandidates;             // heap indexes, self ordered as max-heap
+        };
+
         ThreatContainer() { iDirty = false; }
         ~ThreatContainer() { clearReferences(); }
 
@@ -164,13 +194,16 @@ class MANGOS_DLL_SPEC ThreatContainer
 
         bool isDirty() const { return iDirty; }
 
-        bool empty() const { return(iThreatList.empty()); }
+        bool empty() const { return(iThreatHeap.empty()); }
 
-        HostileReference* getMostHated() { return iThreatList.empty() ? NULL : iThreatList.front(); }
+        HostileReference* getMostHated() { return iThreatHeap.empty() ? NULL : iThreatHeap.front(); }
 
         HostileReference* getReferenceByTarget(Unit* pVictim);
 
-        ThreatList const& getThreatList() const { return iThreatList; }
+        ThreatList const& getThreatList() const { update(); return iThreatList; }
+
+        // for uses not depending from order (client threat packets), no sorting
+        ThreatList const& getUnorderedThreatList() const { return iThreatHeap; }
 };
 
 //=================================================
@@ -217,6 +250,8 @@ class MANGOS_DLL_SPEC ThreatManager
 
         // Don't must be used for explicit modify threat values in iterator return pointers
         ThreatList const& getThreatList() const { return iThreatContainer.getThreatList(); }
+        ThreatList const& getUnorderedThreatList() const { return iThreatContainer.getUnorderedThreatList(); }
+        ThreatContainer const& getThreatContainer() const { return iThreatContainer; }
     private:
         HostileReference* iCurrentVictim;
         Unit* iOwner;
@@ -49,6 +49,7 @@
 #include "MovementGenerator.h"
 #include "movement/MoveSplineInit.h"
 #include "movement/MoveSpline.h"
+#include "CellPositionIndex.h"
 
 #include <math.h>
 #include <stdarg.h>
@@ -9285,6 +9286,9 @@ void Unit::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
+    // queued notify is dropped by map, allow schedule at next add to world
+    m_AINotifyScheduled = false;
+
     Object::RemoveFromWorld();
 }
 
@@ -10040,6 +10044,7 @@ void Unit::UpdateModelData()
     {
         // we expect values in database to be relative to scale = 1.0
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
+        CellPositionIndex::Update(this);
 
         // never actually update combat_reach for player, it's always the same. Below player case is for initialization
         if (GetTypeId() == TYPEID_PLAYER)
@@ -10119,8 +10124,12 @@ Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= NULL*/, float radius /
     std::list<Unit *> targets;
 
     MaNGOS::AnyUnfriendlyUnitInObjectRangeCheck u_check(this, this, radius);
-    MaNGOS::UnitListSearcher<MaNGOS::AnyUnfriendlyUnitInObjectRangeCheck> searcher(targets, u_check);
-    Cell::VisitAllObjects(this, searcher, radius);
+
+    CellPositionUnitList units;
+    GetMap()->SelectUnitsInRange(this, radius, CELL_POSITION_ALL_OBJECTS, units);
+    for(CellPositionUnitList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        if ((*itr)->InSamePhase(this) && u_check(*itr))
+            targets.push_back(*itr);
 
     // remove current target
     if(except)
@@ -10157,9 +10166,13 @@ Unit* Unit::SelectRandomFriendlyTarget(Unit* except /*= NULL*/, float radius /*=
     std::list<Unit *> targets;
 
     MaNGOS::AnyFriendlyUnitInObjectRangeCheck u_check(this, radius);
-    MaNGOS::UnitListSearcher<MaNGOS::AnyFriendlyUnitInObjectRangeCheck> searcher(targets, u_check);
 
-    Cell::VisitAllObjects(this, searcher, radius);
+    CellPositionUnitList units;
+    GetMap()->SelectUnitsInRange(this, radius, CELL_POSITION_ALL_OBJECTS, units);
+    for(CellPositionUnitList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        if ((*itr)->InSamePhase(this) && u_check(*itr))
+            targets.push_back(*itr);
+
     // remove current target
     if(except)
         targets.remove(except);
@@ -10507,7 +10520,8 @@ uint32 Unit::GetCombatRatingDamageReduction(CombatRating cr, float rate, float c
 
 void Unit::SendThreatUpdate()
 {
-    ThreatList const& tlist = getThreatManager().getThreatList();
+    // client sorts threat list itself
+    ThreatList const& tlist = getThreatManager().getUnorderedThreatList();
     if (uint32 count = tlist.size())
     {
         DEBUG_FILTER_LOG(LOG_FILTER_COMBAT, "WORLD: Send SMSG_THREAT_UPDATE Message");
@@ -10525,7 +10539,7 @@ void Unit::SendThreatUpdate()
 
 void Unit::SendHighestThreatUpdate(HostileReference* pHostilReference)
 {
-    ThreatList const& tlist = getThreatManager().getThreatList();
+    ThreatList const& tlist = getThreatManager().getUnorderedThreatList();
     if (uint32 count = tlist.size())
     {
         DEBUG_FILTER_LOG(LOG_FILTER_COMBAT, "WORLD: Send SMSG_HIGHEST_THREAT_UPDATE Message");
@@ -10689,44 +10703,14 @@ bool Unit::IsAllowedDamageInArea(Unit* pVictim) const
     return true;
 }
 
-class RelocationNotifyEvent : public BasicEvent
+void Unit::ScheduleAINotify(uint32 delay)
 {
-public:
-    RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
-    {
-        m_owner._SetAINotifyScheduled(true);
-    }
-
-    bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
-    {
-        float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-        if (m_owner.GetTypeId() == TYPEID_PLAYER)
-        {
-            MaNGOS::PlayerRelocationNotifier notify((Player&)m_owner);
-            Cell::VisitAllObjects(&m_owner,notify,radius);
-        }
-        else //if(m_owner.GetTypeId() == TYPEID_UNIT)
-        {
-            MaNGOS::CreatureRelocationNotifier notify((Creature&)m_owner);
-            Cell::VisitAllObjects(&m_owner,notify,radius);
-        }
-        m_owner._SetAINotifyScheduled(false);
-        return true;
-    }
-
-    void Abort(uint64)
+    // moves are collected by map and notified once per map update for all units of a cell
+    if (!IsAINotifyScheduled() && IsInWorld())
     {
-        m_owner._SetAINotifyScheduled(false);
+        m_AINotifyScheduled = true;
+        GetMap()->ScheduleRelocationNotify(GetObjectGuid(), delay);
     }
-
-private:
-    Unit& m_owner;
-};
-
-void Unit::ScheduleAINotify(uint32 delay)
-{
-    if (!IsAINotifyScheduled())
-        m_Events.AddEvent(new RelocationNotifyEvent(*this), m_Events.CalculateTime(delay));
 }
 
 void Unit::OnRelocated()
@@ -10738,12 +10722,15 @@ void Unit::OnRelocated()
     float distsq = dx*dx+dy*dy+dz*dz;
     if (distsq > World::GetRelocationLowerLimitSq())
     {
+        float oldX = m_last_notified_position.x;
+        float oldY = m_last_notified_position.y;
+
         m_last_notified_position.x = GetPositionX();
         m_last_notified_position.y = GetPositionY();
         m_last_notified_position.z = GetPositionZ();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
-        UpdateObjectVisibility();
+        GetViewPoint().Call_UpdateVisibilityForOwnerAfterMove();
+        GetMap()->UpdateObjectVisibilityAfterMove(this, oldX, oldY);
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
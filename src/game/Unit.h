@@ -1954,7 +1954,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         void ScheduleAINotify(uint32 delay);
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
-        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
+        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from Map::ProcessRelocationNotifies code
         void OnRelocated();
 
     protected:
@@ -20,17 +20,73 @@
 #include "UpdateData.h"
 #include "ByteBuffer.h"
 #include "WorldPacket.h"
+#include "SharedPacket.h"
 #include "Log.h"
 #include "Opcodes.h"
 #include "World.h"
 #include "ObjectGuid.h"
 #include <zlib/zlib.h>
+#include <ace/TSS_T.h>
+
+// deflate stream kept per thread (world and map update threads), reset between packets instead of init/end for each
+class UpdateCompressor
+{
+    public:
+        UpdateCompressor() : m_level(-1) { memset(&m_stream, 0, sizeof(m_stream)); }
+        ~UpdateCompressor() { Close(); }
+
+        // return stream ready for new packet compression, NULL at error
+        z_stream* GetStream(int level)
+        {
+            if (m_level == level)
+            {
+                int z_res = deflateReset(&m_stream);
+                if (z_res == Z_OK)
+                    return &m_stream;
+
+                sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)",z_res,zError(z_res));
+            }
+
+            // first use in thread, compression level changed at config reload or reset failed
+            Close();
+
+            m_stream.zalloc = (alloc_func)0;
+            m_stream.zfree = (free_func)0;
+            m_stream.opaque = (voidpf)0;
+
+            int z_res = deflateInit(&m_stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)",z_res,zError(z_res));
+                return NULL;
+            }
+
+            m_level = level;
+            return &m_stream;
+        }
+
+    private:
+        void Close()
+        {
+            if (m_level < 0)
+                return;
+
+            deflateEnd(&m_stream);
+            m_level = -1;
+        }
+
+        z_stream m_stream;
+        int m_level;                                        // -1 if stream not initialized
+};
+
+typedef ACE_TSS<UpdateCompressor> UpdateCompressorTSS;
+static UpdateCompressorTSS updateCompressor;
 
 UpdateData::UpdateData() : m_blockCount(0)
 {
 }
 
-void UpdateData::AddOutOfRangeGUID(ObjectGuidSet& guids)
+void UpdateData::AddOutOfRangeGUID(ObjectGuidHashSet const& guids)
 {
     m_outOfRangeGUIDs.insert(guids.begin(),guids.end());
 }
@@ -48,27 +104,22 @@ void UpdateData::AddUpdateBlock(const ByteBuffer &block)
 
 void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
-
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* stream = updateCompressor->GetStream(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    if (!stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)",z_res,zError(z_res));
         *dst_size = 0;
         return;
     }
 
+    z_stream& c_stream = *stream;
+
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
     c_stream.next_in = (Bytef*)src;
     c_stream.avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(&c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)",z_res,zError(z_res));
@@ -91,22 +142,14 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)",z_res,zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
 }
 
-bool UpdateData::BuildPacket(WorldPacket *packet)
+size_t UpdateData::BuildPayload(ByteBuffer& buf) const
 {
-    MANGOS_ASSERT(packet->empty());                         // shouldn't happen
+    buf.reserve(buf.wpos() + 4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    size_t start = buf.wpos();
 
     buf << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
 
@@ -121,6 +164,20 @@ bool UpdateData::BuildPacket(WorldPacket *packet)
 
     buf.append(m_data);
 
+    return buf.wpos() - start;
+}
+
+bool UpdateData::BuildPacket(WorldPacket *packet)
+{
+    ByteBuffer buf(0);                                      // BuildPayload reserve exact size
+    BuildPayload(buf);
+    return BuildPacket(packet, buf);
+}
+
+bool UpdateData::BuildPacket(WorldPacket *packet, ByteBuffer const& buf)
+{
+    MANGOS_ASSERT(packet->empty());                         // shouldn't happen
+
     size_t pSize = buf.wpos();                              // use real used data size
 
     if (pSize > 100 )                                       // compress large packets
@@ -129,7 +186,7 @@ bool UpdateData::BuildPacket(WorldPacket *packet)
         packet->resize( destsize + sizeof(uint32) );
 
         packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), int(pSize));
         if (destsize == 0)
             return false;
 
@@ -151,3 +208,57 @@ void UpdateData::Clear()
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
 }
+
+struct UpdatePacketCache::Entry
+{
+    explicit Entry(ByteBuffer const& _payload) : payload(_payload), shared(packet) {}
+
+    ByteBuffer payload;
+    WorldPacket packet;
+    SharedPacket shared;
+};
+
+// FNV-1a, only used to find candidates for full payload compare
+static uint32 HashPayload(ByteBuffer const& buf)
+{
+    uint32 hash = 2166136261U;
+    uint8 const* data = buf.contents();
+    for (size_t i = 0; i < buf.wpos(); ++i)
+    {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+UpdatePacketCache::~UpdatePacketCache()
+{
+    for (EntryMap::const_iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+        delete itr->second;
+}
+
+SharedPacket* UpdatePacketCache::GetPacket(UpdateData const& data)
+{
+    m_payload.clear();
+    data.BuildPayload(m_payload);
+
+    uint32 hash = HashPayload(m_payload);
+
+    std::pair<EntryMap::const_iterator, EntryMap::const_iterator> range = m_entries.equal_range(hash);
+    for (EntryMap::const_iterator itr = range.first; itr != range.second; ++itr)
+    {
+        ByteBuffer const& payload = itr->second->payload;
+        if (payload.wpos() == m_payload.wpos() && memcmp(payload.contents(), m_payload.contents(), m_payload.wpos()) == 0)
+            return &itr->second->shared;
+    }
+
+    Entry* entry = new Entry(m_payload);
+    if (!UpdateData::BuildPacket(&entry->packet, m_payload))
+    {
+        delete entry;
+        return NULL;
+    }
+
+    m_entries.insert(EntryMap::value_type(hash, entry));
+    return &entry->shared;
+}
@@ -23,6 +23,7 @@
 #include "ObjectGuid.h"
 
 class WorldPacket;
+class SharedPacket;
 
 enum ObjectUpdateType
 {
@@ -54,20 +55,53 @@ class UpdateData
     public:
         UpdateData();
 
-        void AddOutOfRangeGUID(ObjectGuidSet& guids);
+        void AddOutOfRangeGUID(ObjectGuidHashSet const& guids);
         void AddOutOfRangeGUID(ObjectGuid const &guid);
         void AddUpdateBlock(const ByteBuffer &block);
         bool BuildPacket(WorldPacket *packet);
+        // fill buf with uncompressed packet payload, return payload size
+        size_t BuildPayload(ByteBuffer& buf) const;
+        // make SMSG_UPDATE_OBJECT or SMSG_COMPRESSED_UPDATE_OBJECT packet from payload built by BuildPayload
+        static bool BuildPacket(WorldPacket *packet, ByteBuffer const& payload);
         bool HasData() { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
 
         ObjectGuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        // zlib compression with configured level, also used for other compressed server packets
+        static void Compress(void* dst, uint32 *dst_size, void* src, int src_size);
+
     protected:
         uint32 m_blockCount;
         ObjectGuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
+};
+
+/**
+ * Packets cache for update sent to many players at once (Map::SendObjectUpdates).
+ *
+ * Players in same area often receive byte-identical update data (same movement/values blocks
+ * in same order), so payload is hashed and for equal payloads already built (and compressed)
+ * packet is returned instead of compressing it again. Returned packet body is also shared by
+ * sockets of all recipients instead of copied. Cache expected to live one broadcast only.
+ */
+class UpdatePacketCache
+{
+    public:
+        UpdatePacketCache() {}
+        ~UpdatePacketCache();
+
+        // return packet for data, NULL if packet can't be build; packet owned by cache
+        SharedPacket* GetPacket(UpdateData const& data);
+
+    private:
+        UpdatePacketCache(UpdatePacketCache const&);
+        UpdatePacketCache& operator=(UpdatePacketCache const&);
+
+        struct Entry;
+        typedef std::multimap<uint32, Entry*> EntryMap;
 
-        void Compress(void* dst, uint32 *dst_size, void* src, int src_size);
+        ByteBuffer m_payload;                               // reused payload buffer of current request
+        EntryMap m_entries;                                 // payload hash -> built packets
 };
 #endif
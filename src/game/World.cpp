@@ -22,6 +22,7 @@
 
 #include "World.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "Config/Config.h"
 #include "Platform/Define.h"
 #include "SystemConfig.h"
@@ -63,6 +64,7 @@
 #include "Util.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
 #include "CharacterDatabaseCleaner.h"
+#include "StartupLoader.h"
 
 INSTANTIATE_SINGLETON_1( World );
 
@@ -80,6 +82,8 @@ float World::m_VisibleObjectGreyDistance      = 0;
 
 float  World::m_relocation_lower_limit_sq     = 10.f * 10.f;
 uint32 World::m_relocation_ai_notify_delay    = 1000u;
+uint32 World::m_relocation_ai_notify_limit    = 1000u;
+float  World::m_visibility_incremental_update_distance = SIZE_OF_GRID_CELL;
 
 /// World constructor
 World::World()
@@ -534,6 +538,23 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0);
+
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_REGION_THREADS, "MapUpdate.Region.Threads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_REGION_THREADS, "MapUpdate.Region.Threads", 0);
+
+    setConfigMin(CONFIG_UINT32_MAP_UPDATE_REGION_MARGIN, "MapUpdate.Region.Margin", 2, 1);
+
+    if (configNoReload(reload, CONFIG_UINT32_GRID_PRELOAD_THREADS, "GridPreload.Threads", 0))
+        setConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS, "GridPreload.Threads", 0);
+
+    setConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD, "GridPreload.LookAhead", 10000);
+    setConfigMin(CONFIG_UINT32_GRID_PRELOAD_COMMIT_TIME, "GridPreload.CommitTime", 5, 1);
+
+    if (configNoReload(reload, CONFIG_UINT32_STARTUP_LOAD_THREADS, "StartupLoad.Threads", 0))
+        setConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS, "StartupLoad.Threads", 0);
+
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -751,6 +772,10 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
 
+    setConfig(CONFIG_BOOL_MOVEMENT_AGGREGATION, "Network.MovementAggregation", false);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_AGGREGATION_NEAR_DISTANCE, "Network.MovementAggregation.NearDistance", 40.0f);
+    setConfig(CONFIG_UINT32_MOVEMENT_AGGREGATION_FAR_INTERVAL, "Network.MovementAggregation.FarInterval", 1000);
+
     if(int clientCacheId = sConfig.GetIntDefault("ClientCacheVersion", 0))
     {
         // overwrite DB/old value
@@ -778,7 +803,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,      "PetUnsummonAtMount", true);
 
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
+    m_relocation_ai_notify_limit = sConfig.GetIntDefault("Visibility.AIRelocationNotifyLimit", 1000u);
     m_relocation_lower_limit_sq  = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit",10), 2);
+    m_visibility_incremental_update_distance = sConfig.GetFloatDefault("Visibility.IncrementalUpdateDistance", SIZE_OF_GRID_CELL);
 
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if(m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
@@ -872,6 +899,14 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    std::string snapshotPath = sConfig.GetStringDefault("DataSnapshotDir", "");
+
+    // empty string keep table snapshots disabled
+    if (!snapshotPath.empty() && snapshotPath.at(snapshotPath.length()-1) != '/' && snapshotPath.at(snapshotPath.length()-1) != '\\')
+        snapshotPath.append("/");
+
+    SQLStorageSnapshot::SetDirectory(snapshotPath);
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -888,6 +923,201 @@ void World::LoadConfigSettings(bool reload)
     sLog.outString( "WORLD: VMap data directory is: %svmaps",m_dataPath.c_str());
 }
 
+static void LoadAchievements()
+{
+    sAchievementMgr.LoadAchievementReferenceList();
+    sAchievementMgr.LoadAchievementCriteriaList();
+    sAchievementMgr.LoadAchievementCriteriaRequirements();
+    sAchievementMgr.LoadRewards();
+    sAchievementMgr.LoadRewardLocales();
+    sAchievementMgr.LoadCompletedAchievements();
+}
+
+static void LoadLocalizationStrings()
+{
+    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
+    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
+    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
+    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
+    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
+    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
+    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
+    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
+}
+
+/// Load static world data (templates, spawns, quests, loot, etc) in parallel where dependencies allow
+static void LoadStaticWorldData(uint32 threads)
+{
+    StartupLoader loader;
+
+    loader.Add("PageTexts", "Loading Page Texts...", sObjectMgr, &ObjectMgr::LoadPageTexts);
+    loader.Add("GameobjectInfo", "Loading Game Object Templates...", sObjectMgr, &ObjectMgr::LoadGameobjectInfo)
+        .After("PageTexts");
+
+    loader.Add("SpellChains", "Loading Spell Chain Data...", sSpellMgr, &SpellMgr::LoadSpellChains);
+    loader.Add("SpellElixirs", "Loading Spell Elixir types...", sSpellMgr, &SpellMgr::LoadSpellElixirs)
+        .After("SpellChains");
+    loader.Add("SpellLearnSkills", "Loading Spell Learn Skills...", sSpellMgr, &SpellMgr::LoadSpellLearnSkills)
+        .After("SpellChains");
+    loader.Add("SpellLearnSpells", "Loading Spell Learn Spells...", sSpellMgr, &SpellMgr::LoadSpellLearnSpells)
+        .After("SpellChains");
+    loader.Add("SpellProcEvents", "Loading Spell Proc Event conditions...", sSpellMgr, &SpellMgr::LoadSpellProcEvents)
+        .After("SpellChains");
+    loader.Add("SpellBonuses", "Loading Spell Bonus Data...", sSpellMgr, &SpellMgr::LoadSpellBonuses)
+        .After("SpellChains");
+    loader.Add("SpellProcItemEnchant", "Loading Spell Proc Item Enchant...", sSpellMgr, &SpellMgr::LoadSpellProcItemEnchant)
+        .After("SpellChains");
+    loader.Add("SpellThreats", "Loading Aggro Spells Definitions...", sSpellMgr, &SpellMgr::LoadSpellThreats)
+        .After("SpellChains");
+
+    loader.Add("GossipText", "Loading NPC Texts...", sObjectMgr, &ObjectMgr::LoadGossipText);
+
+    loader.Add("RandomEnchantments", "Loading Item Random Enchantments Table...", &LoadRandomEnchantmentsTable);
+    loader.Add("Items", "Loading Items...", sObjectMgr, &ObjectMgr::LoadItemPrototypes)
+        .After("RandomEnchantments").After("PageTexts");
+    loader.Add("ItemConverts", "Loading Item converts...", sObjectMgr, &ObjectMgr::LoadItemConverts)
+        .After("Items");
+    loader.Add("ItemExpireConverts", "Loading Item expire converts...", sObjectMgr, &ObjectMgr::LoadItemExpireConverts)
+        .After("Items");
+
+    loader.Add("CreatureModelInfo", "Loading Creature Model Based Info Data...", sObjectMgr, &ObjectMgr::LoadCreatureModelInfo);
+    loader.Add("EquipmentTemplates", "Loading Equipment templates...", sObjectMgr, &ObjectMgr::LoadEquipmentTemplates);
+    loader.Add("CreatureTemplates", "Loading Creature templates...", sObjectMgr, &ObjectMgr::LoadCreatureTemplates)
+        .After("CreatureModelInfo").After("EquipmentTemplates");
+    loader.Add("CreatureModelRace", "Loading Creature Model for race...", sObjectMgr, &ObjectMgr::LoadCreatureModelRace)
+        .After("CreatureTemplates");
+
+    loader.Add("SpellScriptTarget", "Loading SpellsScriptTarget...", sSpellMgr, &SpellMgr::LoadSpellScriptTarget)
+        .After("SpellChains").After("CreatureTemplates").After("GameobjectInfo");
+    loader.Add("ItemRequiredTarget", "Loading ItemRequiredTarget...", sObjectMgr, &ObjectMgr::LoadItemRequiredTarget)
+        .After("Items").After("SpellScriptTarget");
+
+    loader.Add("ReputationRewardRate", "Loading Reputation Reward Rates...", sObjectMgr, &ObjectMgr::LoadReputationRewardRate);
+    loader.Add("ReputationOnKill", "Loading Creature Reputation OnKill Data...", sObjectMgr, &ObjectMgr::LoadReputationOnKill)
+        .After("CreatureTemplates");
+    loader.Add("ReputationSpillover", "Loading Reputation Spillover Data...", sObjectMgr, &ObjectMgr::LoadReputationSpilloverTemplate);
+    loader.Add("PointsOfInterest", "Loading Points Of Interest Data...", sObjectMgr, &ObjectMgr::LoadPointsOfInterest);
+
+    // creature, gameobject and corpse loaders fill same map object guid cells, must be chained
+    loader.Add("Creatures", "Loading Creature Data...", sObjectMgr, &ObjectMgr::LoadCreatures)
+        .After("CreatureTemplates");
+
+    loader.Add("PetLevelupSpells", "Loading pet levelup spells...", sSpellMgr, &SpellMgr::LoadPetLevelupSpellMap)
+        .After("SpellChains");
+    loader.Add("PetDefaultSpells", "Loading pet default spell additional to levelup spells...", sSpellMgr, &SpellMgr::LoadPetDefaultSpells)
+        .After("CreatureTemplates").After("PetLevelupSpells");
+
+    loader.Add("CreatureAddons", "Loading Creature Addon Data...", sObjectMgr, &ObjectMgr::LoadCreatureAddons)
+        .After("CreatureTemplates").After("Creatures");
+
+    loader.Add("Gameobjects", "Loading Gameobject Data...", sObjectMgr, &ObjectMgr::LoadGameobjects)
+        .After("GameobjectInfo").After("Creatures");
+
+    loader.Add("Pool", "Loading Objects Pooling Data...", sPoolMgr, &PoolManager::LoadFromDB)
+        .After("Creatures").After("Gameobjects");
+
+    loader.Add("WeatherZoneChances", "Loading Weather Data...", sObjectMgr, &ObjectMgr::LoadWeatherZoneChances);
+
+    // quest flags are modified by quest, game event, area trigger and script loaders, these are chained
+    loader.Add("Quests", "Loading Quests...", sObjectMgr, &ObjectMgr::LoadQuests)
+        .After("CreatureTemplates").After("Items").After("GameobjectInfo").After("Creatures").After("Gameobjects");
+    loader.Add("QuestPOI", "Loading Quest POI", sObjectMgr, &ObjectMgr::LoadQuestPOI)
+        .After("Quests");
+    loader.Add("QuestRelations", "Loading Quests Relations...", sObjectMgr, &ObjectMgr::LoadQuestRelations)
+        .After("Quests");
+
+    loader.Add("GameEvent", "Loading Game Event Data...", sGameEventMgr, &GameEventMgr::LoadFromDB)
+        .After("Pool").After("QuestRelations").After("Items").After("EquipmentTemplates");
+
+    loader.Add("InitWorldMaps", "Creating map persistent states for non-instanceable maps...", sMapPersistentStateMgr, &MapPersistentStateManager::InitWorldMaps)
+        .After("Creatures").After("Pool").After("GameEvent");
+    loader.Add("CreatureRespawnTimes", "Loading Creature Respawn Data...", sMapPersistentStateMgr, &MapPersistentStateManager::LoadCreatureRespawnTimes)
+        .After("Creatures").After("InitWorldMaps");
+    loader.Add("GameobjectRespawnTimes", "Loading Gameobject Respawn Data...", sMapPersistentStateMgr, &MapPersistentStateManager::LoadGameobjectRespawnTimes)
+        .After("Gameobjects").After("CreatureRespawnTimes");
+
+    loader.Add("NPCSpellClickSpells", "Loading UNIT_NPC_FLAG_SPELLCLICK Data...", sObjectMgr, &ObjectMgr::LoadNPCSpellClickSpells)
+        .After("CreatureTemplates").After("Quests");
+    loader.Add("SpellAreas", "Loading SpellArea Data...", sSpellMgr, &SpellMgr::LoadSpellAreas)
+        .After("SpellChains").After("Quests");
+    loader.Add("AreaTriggerTeleports", "Loading AreaTrigger definitions...", sObjectMgr, &ObjectMgr::LoadAreaTriggerTeleports)
+        .After("Items").After("Quests");
+    loader.Add("QuestAreaTriggers", "Loading Quest Area Triggers...", sObjectMgr, &ObjectMgr::LoadQuestAreaTriggers)
+        .After("GameEvent");
+    loader.Add("TavernAreaTriggers", "Loading Tavern Area Triggers...", sObjectMgr, &ObjectMgr::LoadTavernAreaTriggers);
+    loader.Add("AreaTriggerScripts", "Loading AreaTrigger script names...", sScriptMgr, &ScriptMgr::LoadAreaTriggerScripts);
+    loader.Add("EventIdScripts", "Loading event id script names...", sScriptMgr, &ScriptMgr::LoadEventIdScripts)
+        .After("GameobjectInfo");
+    loader.Add("GraveyardZones", "Loading Graveyard-zone links...", sObjectMgr, &ObjectMgr::LoadGraveyardZones);
+
+    loader.Add("SpellTargetPositions", "Loading spell target destination coordinates...", sSpellMgr, &SpellMgr::LoadSpellTargetPositions)
+        .After("SpellChains");
+    loader.Add("SpellPetAuras", "Loading spell pet auras...", sSpellMgr, &SpellMgr::LoadSpellPetAuras)
+        .After("SpellChains");
+
+    loader.Add("PlayerInfo", "Loading Player Create Info & Level Stats...", sObjectMgr, &ObjectMgr::LoadPlayerInfo)
+        .After("Items").After("SpellChains");
+    loader.Add("ExplorationBaseXP", "Loading Exploration BaseXP Data...", sObjectMgr, &ObjectMgr::LoadExplorationBaseXP);
+    loader.Add("PetNames", "Loading Pet Name Parts...", sObjectMgr, &ObjectMgr::LoadPetNames);
+
+    loader.Add("CharacterDatabaseCleaner", NULL, &CharacterDatabaseCleaner::CleanDatabase);
+
+    loader.Add("PetNumber", "Loading the max pet number...", sObjectMgr, &ObjectMgr::LoadPetNumber);
+    loader.Add("PetLevelInfo", "Loading pet level stats...", sObjectMgr, &ObjectMgr::LoadPetLevelInfo)
+        .After("CreatureTemplates");
+    loader.Add("Corpses", "Loading Player Corpses...", sObjectMgr, &ObjectMgr::LoadCorpses)
+        .After("GameobjectRespawnTimes");
+    loader.Add("MailLevelRewards", "Loading Player level dependent mail rewards...", sObjectMgr, &ObjectMgr::LoadMailLevelRewards)
+        .After("CreatureTemplates");
+
+    // loot and gossip menu loaders register player conditions in shared list, must be chained
+    loader.Add("LootTables", "Loading Loot Tables...", &LoadLootTables)
+        .After("Items").After("CreatureTemplates").After("GameobjectInfo").After("SpellChains").After("QuestAreaTriggers");
+
+    loader.Add("SkillDiscovery", "Loading Skill Discovery Table...", &LoadSkillDiscoveryTable)
+        .After("SpellChains");
+    loader.Add("SkillExtraItems", "Loading Skill Extra Item Table...", &LoadSkillExtraItemTable)
+        .After("SpellChains");
+    loader.Add("FishingBaseSkillLevel", "Loading Skill Fishing base level requirements...", sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel);
+
+    loader.Add("Achievements", "Loading Achievements...", &LoadAchievements)
+        .After("Items").After("CreatureTemplates").After("QuestAreaTriggers").After("CharacterDatabaseCleaner");
+
+    loader.Add("InstanceEncounters", "Loading Instance encounters data...", sObjectMgr, &ObjectMgr::LoadInstanceEncounters)
+        .After("CreatureTemplates");
+    loader.Add("NpcGossips", "Loading Npc Text Id...", sObjectMgr, &ObjectMgr::LoadNpcGossips)
+        .After("Creatures").After("GossipText");
+
+    loader.Add("GossipScripts", "Loading Gossip scripts...", sScriptMgr, &ScriptMgr::LoadGossipScripts)
+        .After("QuestAreaTriggers").After("Items").After("Creatures").After("Gameobjects").After("SpellChains");
+    loader.Add("GossipMenu", "Loading Gossip menus...", sObjectMgr, &ObjectMgr::LoadGossipMenu)
+        .After("GossipText").After("GossipScripts").After("LootTables");
+    loader.Add("GossipMenuItems", "Loading Gossip menu options...", sObjectMgr, &ObjectMgr::LoadGossipMenuItems)
+        .After("GossipMenu").After("PointsOfInterest");
+
+    loader.Add("VendorTemplates", "Loading Vendor templates...", sObjectMgr, &ObjectMgr::LoadVendorTemplates)
+        .After("Items").After("CreatureTemplates");
+    loader.Add("Vendors", "Loading Vendors...", sObjectMgr, &ObjectMgr::LoadVendors)
+        .After("VendorTemplates");
+
+    loader.Add("TrainerTemplates", "Loading Trainer templates...", sObjectMgr, &ObjectMgr::LoadTrainerTemplates)
+        .After("CreatureTemplates").After("SpellLearnSpells");
+    loader.Add("Trainers", "Loading Trainers...", sObjectMgr, &ObjectMgr::LoadTrainers)
+        .After("TrainerTemplates");
+
+    loader.Add("CreatureMovementScripts", "Loading Waypoint scripts...", sScriptMgr, &ScriptMgr::LoadCreatureMovementScripts)
+        .After("GossipScripts");
+    loader.Add("Waypoints", "Loading Waypoints...", sWaypointMgr, &WaypointManager::Load)
+        .After("Creatures").After("CreatureMovementScripts");
+
+    // locale index list is extended by every locale loader, including achievement reward locales
+    loader.Add("Locales", "Loading Localization strings...", &LoadLocalizationStrings)
+        .After("CreatureTemplates").After("GameobjectInfo").After("Items").After("Quests").After("GossipText")
+        .After("PageTexts").After("GossipMenuItems").After("PointsOfInterest").After("Achievements");
+
+    loader.Run(threads);
+}
+
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
@@ -971,256 +1201,8 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
     sLog.outString();
 
-    sLog.outString( "Loading Page Texts..." );
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString( "Loading Game Object Templates..." );   // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString( "Loading Spell Chain Data..." );
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString( "Loading Spell Elixir types..." );
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString( "Loading Spell Learn Skills..." );
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString( "Loading Spell Learn Spells..." );
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString( "Loading Spell Proc Event conditions..." );
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString( "Loading Spell Bonus Data..." );
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString( "Loading Spell Proc Item Enchant..." );
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString( "Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString( "Loading NPC Texts..." );
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString( "Loading Item Random Enchantments Table..." );
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Items...");                     // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString( "Loading Creature Model Based Info Data..." );
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString( "Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString( "Loading Creature templates..." );
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString( "Loading Creature Model for race..." ); // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
-
-    sLog.outString( "Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString( "Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString( "Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString( "Loading Creature Reputation OnKill Data..." );
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString( "Loading Reputation Spillover Data..." );
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString( "Loading Points Of Interest Data..." );
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString( "Loading Creature Data..." );
-    sObjectMgr.LoadCreatures();
-
-    sLog.outString( "Loading pet levelup spells..." );
-    sSpellMgr.LoadPetLevelupSpellMap();
-
-    sLog.outString( "Loading pet default spell additional to levelup spells..." );
-    sSpellMgr.LoadPetDefaultSpells();
-
-    sLog.outString( "Loading Creature Addon Data..." );
-    sLog.outString();
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString( ">>> Creature Addon Data loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Gameobject Data..." );
-    sObjectMgr.LoadGameobjects();
-
-    sLog.outString( "Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
-
-    sLog.outString( "Loading Weather Data..." );
-    sObjectMgr.LoadWeatherZoneChances();
-
-    sLog.outString( "Loading Quests..." );
-    sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog.outString( "Loading Quest POI" );
-    sObjectMgr.LoadQuestPOI();
-
-    sLog.outString( "Loading Quests Relations..." );
-    sLog.outString();
-    sObjectMgr.LoadQuestRelations();                        // must be after quest load
-    sLog.outString( ">>> Quests Relations loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Game Event Data...");          // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events
-    sLog.outString();
-    sGameEventMgr.LoadFromDB();
-    sLog.outString( ">>> Game Event Data loaded" );
-    sLog.outString();
-
-    sLog.outString( "Creating map persistent states for non-instanceable maps..." );   // must be after PackInstances(), LoadCreatures(), sPoolMgr.LoadFromDB(), sGameEventMgr.LoadFromDB();
-    sMapPersistentStateMgr.InitWorldMaps();
-
-    sLog.outString( "Loading Creature Respawn Data..." );   // must be after LoadCreatures(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadCreatureRespawnTimes();
-
-    sLog.outString( "Loading Gameobject Respawn Data..." ); // must be after LoadGameobjects(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
-
-    sLog.outString( "Loading UNIT_NPC_FLAG_SPELLCLICK Data..." );
-    sObjectMgr.LoadNPCSpellClickSpells();
-
-    sLog.outString( "Loading SpellArea Data..." );          // must be after quest load
-    sSpellMgr.LoadSpellAreas();
-
-    sLog.outString( "Loading AreaTrigger definitions..." );
-    sObjectMgr.LoadAreaTriggerTeleports();                  // must be after item template load
-
-    sLog.outString( "Loading Quest Area Triggers..." );
-    sObjectMgr.LoadQuestAreaTriggers();                     // must be after LoadQuests
-
-    sLog.outString( "Loading Tavern Area Triggers..." );
-    sObjectMgr.LoadTavernAreaTriggers();
-
-    sLog.outString( "Loading AreaTrigger script names..." );
-    sScriptMgr.LoadAreaTriggerScripts();
-
-    sLog.outString( "Loading event id script names..." );
-    sScriptMgr.LoadEventIdScripts();
-
-    sLog.outString( "Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
-
-    sLog.outString( "Loading spell target destination coordinates..." );
-    sSpellMgr.LoadSpellTargetPositions();
-
-    sLog.outString( "Loading spell pet auras..." );
-    sSpellMgr.LoadSpellPetAuras();
-
-    sLog.outString( "Loading Player Create Info & Level Stats..." );
-    sLog.outString();
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString( ">>> Player Create Info & Level Stats loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Exploration BaseXP Data..." );
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString( "Loading Pet Name Parts..." );
-    sObjectMgr.LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-
-    sLog.outString( "Loading the max pet number..." );
-    sObjectMgr.LoadPetNumber();
-
-    sLog.outString( "Loading pet level stats..." );
-    sObjectMgr.LoadPetLevelInfo();
-
-    sLog.outString( "Loading Player Corpses..." );
-    sObjectMgr.LoadCorpses();
-
-    sLog.outString( "Loading Player level dependent mail rewards..." );
-    sObjectMgr.LoadMailLevelRewards();
-
-    sLog.outString( "Loading Loot Tables..." );
-    sLog.outString();
-    LoadLootTables();
-    sLog.outString( ">>> Loot Tables loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Skill Discovery Table..." );
-    LoadSkillDiscoveryTable();
-
-    sLog.outString( "Loading Skill Extra Item Table..." );
-    LoadSkillExtraItemTable();
-
-    sLog.outString( "Loading Skill Fishing base level requirements..." );
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString( "Loading Achievements..." );
-    sLog.outString();
-    sAchievementMgr.LoadAchievementReferenceList();
-    sAchievementMgr.LoadAchievementCriteriaList();
-    sAchievementMgr.LoadAchievementCriteriaRequirements();
-    sAchievementMgr.LoadRewards();
-    sAchievementMgr.LoadRewardLocales();
-    sAchievementMgr.LoadCompletedAchievements();
-    sLog.outString( ">>> Achievements loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Instance encounters data..." );  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString( "Loading Npc Text Id..." );
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadGossipText
-
-    sLog.outString( "Loading Gossip scripts..." );
-    sScriptMgr.LoadGossipScripts();                         // must be before gossip menu options
-
-    sLog.outString( "Loading Gossip menus..." );
-    sObjectMgr.LoadGossipMenu();
-
-    sLog.outString( "Loading Gossip menu options..." );
-    sObjectMgr.LoadGossipMenuItems();
-
-    sLog.outString( "Loading Vendors..." );
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString( "Loading Trainers..." );
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
-
-    sLog.outString( "Loading Waypoint scripts..." );        // before loading from creature_movement
-    sScriptMgr.LoadCreatureMovementScripts();
-
-    sLog.outString( "Loading Waypoints..." );
-    sLog.outString();
-    sWaypointMgr.Load();
-
-    ///- Loading localization data
-    sLog.outString( "Loading Localization strings..." );
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sLog.outString( ">>> Localization strings loaded" );
-    sLog.outString();
+    ///- Load static world data, independent loaders run concurrently with StartupLoad.Threads > 1
+    LoadStaticWorldData(getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
 
     ///- Load dynamic data tables from the database
     sLog.outString( "Loading Auctions..." );
@@ -88,6 +88,13 @@ enum eConfigUInt32Values
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
+    CONFIG_UINT32_MAP_UPDATE_THREADS,
+    CONFIG_UINT32_MAP_UPDATE_REGION_THREADS,
+    CONFIG_UINT32_MAP_UPDATE_REGION_MARGIN,
+    CONFIG_UINT32_GRID_PRELOAD_THREADS,
+    CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_UINT32_GRID_PRELOAD_COMMIT_TIME,
+    CONFIG_UINT32_STARTUP_LOAD_THREADS,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_GAME_TYPE,
@@ -188,6 +195,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GUID_RESERVE_SIZE_CREATURE,
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_MIN_LEVEL_FOR_RAID,
+    CONFIG_UINT32_MOVEMENT_AGGREGATION_FAR_INTERVAL,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -274,6 +282,7 @@ enum eConfigFloatValues
     CONFIG_FLOAT_THREAT_RADIUS,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
+    CONFIG_FLOAT_MOVEMENT_AGGREGATION_NEAR_DISTANCE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -328,6 +337,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_JOIN,
     CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_EXIT,
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
+    CONFIG_BOOL_MOVEMENT_AGGREGATION,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
@@ -564,6 +574,8 @@ class World
 
         static float GetRelocationLowerLimitSq()            { return m_relocation_lower_limit_sq; }
         static uint32 GetRelocationAINotifyDelay()          { return m_relocation_ai_notify_delay; }
+        static uint32 GetRelocationAINotifyLimit()          { return m_relocation_ai_notify_limit; }
+        static float GetVisibilityIncrementalUpdateDistance() { return m_visibility_incremental_update_distance; }
 
         void ProcessCliCommands();
         void QueueCliCommand(CliCommandHolder* commandHolder) { cliCmdQueue.add(commandHolder); }
@@ -652,6 +664,8 @@ class World
 
         static float  m_relocation_lower_limit_sq;
         static uint32 m_relocation_ai_notify_delay;
+        static uint32 m_relocation_ai_notify_limit;
+        static float  m_visibility_incremental_update_distance;
 
         // CLI command holder to be thread safe
         ACE_Based::LockedQueue<CliCommandHolder*,ACE_Thread_Mutex> cliCmdQueue;
@@ -26,6 +26,8 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedPacket.h"
+#include "UpdateData.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "ObjectMgr.h"
@@ -85,7 +87,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket *sock, AccountTypes sec, uint8
 m_muteTime(mute_time), _player(NULL), m_Socket(sock),_security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
 m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
 m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
-m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
+m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_movementCount(0), m_farMovementTimer(0)
 {
     if (sock)
     {
@@ -127,15 +129,11 @@ char const* WorldSession::GetPlayerName() const
     return GetPlayer() ? GetPlayer()->GetName() : "<none>";
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet)
-{
-    if (!m_Socket)
-        return;
+#ifdef MANGOS_DEBUG
 
-    #ifdef MANGOS_DEBUG
-
-    // Code for network use statistic
+/// Code for network use statistic
+static void CountSentPacket(WorldPacket const* packet)
+{
     static uint64 sendPacketCount = 0;
     static uint64 sendPacketBytes = 0;
 
@@ -166,13 +164,172 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         sendLastPacketCount = 1;
         sendLastPacketBytes = packet->wpos();               // wpos is real written size
     }
+}
+
+#endif                                                      // !MANGOS_DEBUG
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (!m_Socket)
+        return;
 
+    #ifdef MANGOS_DEBUG
+    CountSentPacket(packet);
     #endif                                                  // !MANGOS_DEBUG
 
     if (m_Socket->SendPacket (*packet) == -1)
         m_Socket->CloseSocket ();
 }
 
+/// Send a packet shared with other sessions to the client
+void WorldSession::SendPacket(SharedPacket& packet)
+{
+    if (!m_Socket)
+        return;
+
+    #ifdef MANGOS_DEBUG
+    CountSentPacket(&packet.GetPacket());
+    #endif                                                  // !MANGOS_DEBUG
+
+    if (m_Socket->SendPacket (packet) == -1)
+        m_Socket->CloseSocket ();
+}
+
+// movement batch entry, size include opcode
+static void WriteMovementEntry(ByteBuffer& buf, WorldPacket const& packet)
+{
+    buf << uint8(packet.size() + 2);
+    buf << uint16(packet.GetOpcode());
+    if (!packet.empty())
+        buf.append(packet.contents(), packet.size());
+}
+
+/// Send movement packet of other unit: monster moves are collected and sent at map update end, far heartbeats are throttled
+void WorldSession::SendMovementPacket(WorldPacket const& packet, ObjectGuid const& mover, bool isFar)
+{
+    uint16 opcode = packet.GetOpcode();
+
+    // only monster moves can be wrapped in SMSG_COMPRESSED_MOVES
+    if (opcode == SMSG_MONSTER_MOVE || opcode == SMSG_MONSTER_MOVE_TRANSPORT)
+    {
+        // too large for batch entry, send at once after already queued movement
+        if (packet.size() + 2 > 0xFF)
+        {
+            SendMovementBatch(0);
+            SendPacket(&packet);
+            return;
+        }
+
+        ACE_Guard<ACE_Thread_Mutex> guard(m_movementLock);
+
+        if (!m_farMovements.empty())
+            m_farMovements.erase(mover);
+
+        WriteMovementEntry(m_movementBatch, packet);
+        ++m_movementCount;
+        return;
+    }
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_movementLock);
+
+        // far movers send only last heartbeat from time to time
+        if (isFar && opcode == MSG_MOVE_HEARTBEAT)
+        {
+            m_farMovements[mover] = packet;
+            return;
+        }
+
+        // not sent heartbeat is outdated by any newer movement packet
+        if (!m_farMovements.empty())
+            m_farMovements.erase(mover);
+    }
+
+    SendPacket(&packet);
+}
+
+/// Forget not sent heartbeat of mover that is not visible for player anymore
+void WorldSession::RemoveMovementOf(ObjectGuid const& mover)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_movementLock);
+
+    if (!m_farMovements.empty())
+        m_farMovements.erase(mover);
+}
+
+/// Drop all queued movement, called when player leave map or teleport
+void WorldSession::ClearMovementBatch()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_movementLock);
+
+    m_movementBatch.clear();
+    m_movementCount = 0;
+    m_farMovements.clear();
+    m_farMovementTimer = 0;
+}
+
+/// Send queued movement packets as one compressed packet
+void WorldSession::SendMovementBatch(uint32 diff)
+{
+    WorldPacket packet;
+    FarMovementMap farMovements;
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_movementLock);
+
+        if (!m_farMovements.empty())
+        {
+            m_farMovementTimer += diff;
+            if (m_farMovementTimer >= sWorld.getConfig(CONFIG_UINT32_MOVEMENT_AGGREGATION_FAR_INTERVAL))
+            {
+                farMovements.swap(m_farMovements);
+                m_farMovementTimer = 0;
+            }
+        }
+    }
+
+    // heartbeats are not monster moves and can't be wrapped
+    for (FarMovementMap::const_iterator itr = farMovements.begin(); itr != farMovements.end(); ++itr)
+        SendPacket(&itr->second);
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_movementLock);
+
+        if (!m_movementCount)
+            return;
+
+        if (m_movementCount == 1)
+        {
+            // single packet not need wrapper
+            uint8 size = m_movementBatch.read<uint8>(0);
+            packet.Initialize(m_movementBatch.read<uint16>(1), size - 2);
+            if (size > 2)
+                packet.append(m_movementBatch.contents() + 3, size - 2);
+        }
+        else
+        {
+            uint32 pSize = m_movementBatch.wpos();
+            uint32 destsize = compressBound(pSize);
+
+            packet.Initialize(SMSG_COMPRESSED_MOVES, destsize + sizeof(uint32));
+            packet.resize(destsize + sizeof(uint32));
+            packet.put<uint32>(0, pSize);
+            UpdateData::Compress(const_cast<uint8*>(packet.contents()) + sizeof(uint32), &destsize, (void*)m_movementBatch.contents(), int(pSize));
+            packet.resize(destsize + sizeof(uint32));
+        }
+
+        m_movementBatch.clear();
+        m_movementCount = 0;
+
+        // compression error already logged, movement is lost but next heartbeats fix it
+        if (packet.GetOpcode() == SMSG_COMPRESSED_MOVES && packet.size() == sizeof(uint32))
+            return;
+    }
+
+    SendPacket(&packet);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -296,7 +453,8 @@ bool WorldSession::Update(PacketFilter& updater)
             }
         }
 
-        delete packet;
+        // socket reuse packet for next incoming data
+        m_Socket->RecycleRecvPacket(packet);
     }
 
     ///- Cleanup socket pointer if need
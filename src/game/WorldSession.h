@@ -24,6 +24,8 @@
 #define __WORLDSESSION_H
 
 #include "Common.h"
+#include "ByteBuffer.h"
+#include "MPSCQueue.h"
 #include "SharedDefines.h"
 #include "ObjectGuid.h"
 #include "AuctionHouseMgr.h"
@@ -41,6 +43,7 @@ class Object;
 class Player;
 class Unit;
 class WorldPacket;
+class SharedPacket;
 class WorldSocket;
 class QueryResult;
 class LoginQueryHolder;
@@ -241,6 +244,15 @@ class MANGOS_DLL_SPEC WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(SharedPacket& packet);
+        // send movement packet of other unit, monster moves are queued for batched send (Network.MovementAggregation)
+        void SendMovementPacket(WorldPacket const& packet, ObjectGuid const& mover, bool isFar);
+        // send queued movement packets, called at end of map update
+        void SendMovementBatch(uint32 diff);
+        // forget not sent movement of mover gone out of sight
+        void RemoveMovementOf(ObjectGuid const& mover);
+        // drop all queued movement at leave map or teleport
+        void ClearMovementBatch();
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(int32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -358,7 +370,7 @@ class MANGOS_DLL_SPEC WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction);
         static void SendAuctionOutbiddedMail(AuctionEntry *auction);
         void SendAuctionCancelledToBidderMail(AuctionEntry *auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
+        void BuildListAuctionItems(AuctionHouseObject const* auctionHouse, AuctionSorter const& sorter, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
             uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull);
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid);
@@ -891,7 +903,14 @@ class MANGOS_DLL_SPEC WorldSession
         uint32 m_Tutorials[8];
         TutorialDataState m_tutorialState;
         AddonsList m_addonsList;
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        ACE_Based::MPSCQueue<WorldPacket*> _recvQueue;
+
+        typedef std::map<ObjectGuid, WorldPacket> FarMovementMap;
+        ACE_Thread_Mutex m_movementLock;
+        ByteBuffer m_movementBatch;                         // [uint8 size][uint16 opcode][body] for each queued monster move
+        uint32 m_movementCount;
+        FarMovementMap m_farMovements;                      // last not sent heartbeat of far movers
+        uint32 m_farMovementTimer;
 };
 #endif
 /// @}
@@ -23,11 +23,13 @@
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/OS_NS_string.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
 
 #include "WorldSocket.h"
+#include "SharedPacket.h"
 #include "Common.h"
 
 #include "Util.h"
@@ -43,6 +45,24 @@
 #include "Log.h"
 #include "DBCStores.h"
 
+/// Shared packets with smaller body are copied to the output buffer, it's cheaper than referencing.
+static const size_t SHARED_PACKET_COPY_LIMIT = 512;
+
+/// Minimal capacity of buffer allocated for copied packets in the output queue.
+static const size_t OUT_QUEUE_BLOCK_SIZE = 4096;
+
+/// Socket closed when not sent data in the output queue exceed this.
+static const size_t OUT_QUEUE_MAX_SIZE = 8*1024*1024;
+
+/// Max amount of parts (output buffer, headers and bodies) written by one writev.
+static const int OUT_IOV_MAX = 64;
+
+/// Max amount of processed incoming packets kept for reuse.
+static const long RECV_PACKET_POOL_SIZE = 16;
+
+/// Bigger incoming packets are not reused, to not keep rare big allocations in the pool.
+static const size_t RECV_PACKET_POOL_MAX_PACKET_SIZE = 512;
+
 #if defined( __GNUC__ )
 #pragma pack(1)
 #else
@@ -102,17 +122,16 @@ m_LastPingTime (ACE_Time_Value::zero),
 m_OverSpeedPings (0),
 m_Session (0),
 m_RecvWPct (0),
+m_RecvPacketPoolSize (0),
 m_RecvPct (),
 m_Header (sizeof (ClientPktHeader)),
 m_OutBuffer (0),
 m_OutBufferSize (65536),
+m_OutQueueSize (0),
 m_OutActive (false),
 m_Seed (static_cast<uint32> (rand32 ()))
 {
     reference_counting_policy ().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
-
-    msg_queue()->high_water_mark(8*1024*1024);
-    msg_queue()->low_water_mark(8*1024*1024);
 }
 
 WorldSocket::~WorldSocket (void)
@@ -120,9 +139,16 @@ WorldSocket::~WorldSocket (void)
     if (m_RecvWPct)
         delete m_RecvWPct;
 
+    WorldPacket* packet;
+    while (m_RecvPacketPool.next (packet))
+        delete packet;
+
     if (m_OutBuffer)
         m_OutBuffer->release ();
 
+    for (OutPacketQueue::const_iterator itr = m_OutQueue.begin(); itr != m_OutQueue.end(); ++itr)
+        itr->buffer->RemoveReference();
+
     closing_ = true;
 
     peer ().close ();
@@ -158,6 +184,16 @@ const std::string& WorldSocket::GetRemoteAddress (void) const
 }
 
 int WorldSocket::SendPacket (const WorldPacket& pct)
+{
+    return SendPacket (pct, NULL);
+}
+
+int WorldSocket::SendPacket (SharedPacket& pct)
+{
+    return SendPacket (pct.GetPacket (), &pct);
+}
+
+int WorldSocket::SendPacket (const WorldPacket& pct, SharedPacket* shared)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
@@ -165,12 +201,36 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
         return -1;
 
     // Dump outgoing packet.
-    sLog.outWorldPacketDump(uint32(get_handle()), pct.GetOpcode(), LookupOpcodeName(pct.GetOpcode()), &pct, false);
+    if (sLog.IsOutWorldPacketDump())
+        sLog.outWorldPacketDump(uint32(get_handle()), pct.GetOpcode(), LookupOpcodeName(pct.GetOpcode()), &pct, false);
 
     ServerPktHeader header(pct.size()+2, pct.GetOpcode());
     m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
-    if (m_OutBuffer->space () >= pct.size () + header.getHeaderLength() && msg_queue()->is_empty())
+    const size_t pct_len = pct.size () + header.getHeaderLength();
+
+    if (m_OutQueueSize + pct_len > OUT_QUEUE_MAX_SIZE)
+    {
+        sLog.outError("WorldSocket::SendPacket output queue overflow");
+        return -1;
+    }
+
+    // Reference big shared packet body, only the header is per socket.
+    if (shared && pct.size () >= SHARED_PACKET_COPY_LIMIT)
+    {
+        OutPacket out;
+        memcpy (out.header, header.header, header.getHeaderLength());
+        out.headerSize = header.getHeaderLength();
+        out.buffer = shared->GetBuffer ();
+        out.buffer->AddReference ();
+        out.sent = 0;
+
+        m_OutQueue.push_back (out);
+        m_OutQueueSize += pct_len;
+        return 0;
+    }
+
+    if (m_OutBuffer->space () >= pct_len && m_OutQueue.empty())
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy ((char*) header.header, header.getHeaderLength()) == -1)
@@ -179,30 +239,58 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
         if (!pct.empty ())
             if (m_OutBuffer->copy ((char*) pct.contents (), pct.size ()) == -1)
                 MANGOS_ASSERT (false);
+
+        return 0;
     }
-    else
+
+    // Enqueue the packet, small packets are copied together into one not shared buffer.
+    if (m_OutQueue.empty() || m_OutQueue.back().headerSize != 0 ||
+        m_OutQueue.back().buffer->IsShared() || m_OutQueue.back().buffer->GetSpace() < pct_len)
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        OutPacket out;
+        out.headerSize = 0;
+        out.buffer = PacketBuffer::Create (std::max (pct_len, OUT_QUEUE_BLOCK_SIZE));
+        out.sent = 0;
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size () + header.getHeaderLength()), -1);
+        m_OutQueue.push_back (out);
+    }
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+    PacketBuffer* buffer = m_OutQueue.back().buffer;
 
-        if (!pct.empty ())
-            mb->copy((const char*)pct.contents(), pct.size ());
+    buffer->Append (header.header, header.getHeaderLength());
 
-        if(msg_queue()->enqueue_tail(mb,(ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            sLog.outError("WorldSocket::SendPacket enqueue_tail");
-            mb->release();
-            return -1;
-        }
-    }
+    if (!pct.empty ())
+        buffer->Append (pct.contents (), pct.size ());
 
+    m_OutQueueSize += pct_len;
     return 0;
 }
 
+void WorldSocket::RecycleRecvPacket (WorldPacket* packet)
+{
+    if (packet->size () > RECV_PACKET_POOL_MAX_PACKET_SIZE || m_RecvPacketPoolSize.value () >= RECV_PACKET_POOL_SIZE)
+    {
+        delete packet;
+        return;
+    }
+
+    ++m_RecvPacketPoolSize;
+    m_RecvPacketPool.add (packet);
+}
+
+WorldPacket* WorldSocket::AllocRecvPacket (uint16 opcode, size_t size)
+{
+    WorldPacket* packet;
+    if (m_RecvPacketPool.next (packet))
+    {
+        --m_RecvPacketPoolSize;
+        packet->Initialize (opcode, size);
+        return packet;
+    }
+
+    return new WorldPacket (opcode, size);
+}
+
 long WorldSocket::AddReference (void)
 {
     return static_cast<long> (add_reference ());
@@ -326,15 +414,52 @@ int WorldSocket::handle_output (ACE_HANDLE)
     if (closing_)
         return -1;
 
-    const size_t send_len = m_OutBuffer->length ();
+    // Collect the output buffer and the queued headers and bodies for one writev.
+    iovec iov[OUT_IOV_MAX];
+    int iov_count = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length () > 0)
+    {
+        iov[iov_count].iov_base = m_OutBuffer->rd_ptr ();
+        iov[iov_count].iov_len = m_OutBuffer->length ();
+        send_len += iov[iov_count++].iov_len;
+    }
+
+    for (OutPacketQueue::iterator itr = m_OutQueue.begin(); itr != m_OutQueue.end() && iov_count + 2 <= OUT_IOV_MAX; ++itr)
+    {
+        size_t skip = itr->sent;
+
+        if (skip < itr->headerSize)
+        {
+            iov[iov_count].iov_base = (char*) itr->header + skip;
+            iov[iov_count].iov_len = itr->headerSize - skip;
+            send_len += iov[iov_count++].iov_len;
+            skip = 0;
+        }
+        else
+            skip -= itr->headerSize;
+
+        if (skip < itr->buffer->GetSize ())
+        {
+            iov[iov_count].iov_base = (char*) itr->buffer->GetData () + skip;
+            iov[iov_count].iov_len = itr->buffer->GetSize () - skip;
+            send_len += iov[iov_count++].iov_len;
+        }
+    }
 
     if (send_len == 0)
-        return handle_output_queue (Guard);
+        return cancel_wakeup_output (Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer ().send (m_OutBuffer->rd_ptr (), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset (&msg, 0, sizeof (msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_count;
+
+    ssize_t n = ACE_OS::sendmsg (get_handle (), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer ().send (m_OutBuffer->rd_ptr (), send_len);
+    ssize_t n = peer ().sendv (iov, iov_count);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -346,84 +471,51 @@ int WorldSocket::handle_output (ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch ();
+    ConsumeOutput (static_cast<size_t> (n));
 
+    if (n < (ssize_t)send_len)
         return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
-    {
-        m_OutBuffer->reset ();
-
-        return handle_output_queue (Guard);
-    }
 
-    ACE_NOTREACHED (return 0);
+    // all collected data sent, call again if the queue was longer than OUT_IOV_MAX
+    return m_OutQueue.empty() ? cancel_wakeup_output (Guard) : ACE_Event_Handler::WRITE_MASK;
 }
 
-int WorldSocket::handle_output_queue (GuardType& g)
+void WorldSocket::ConsumeOutput (size_t n)
 {
-    if(msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block *mblk;
+    const size_t buffer_len = m_OutBuffer->length ();
 
-    if(msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    if (n < buffer_len)
     {
-        sLog.outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
+        m_OutBuffer->rd_ptr (n);
 
-    const size_t send_len = mblk->length ();
+        // move the data to the base of the buffer
+        m_OutBuffer->crunch ();
+        return;
+    }
 
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer ().send (mblk->rd_ptr (), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer ().send (mblk->rd_ptr (), send_len);
-#endif // MSG_NOSIGNAL
+    m_OutBuffer->reset ();
+    n -= buffer_len;
 
-    if (n == 0)
-    {
-        mblk->release();
+    m_OutQueueSize -= n;
 
-        return -1;
-    }
-    else if (n == -1)
+    while (n > 0)
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
-        }
+        MANGOS_ASSERT (!m_OutQueue.empty());
 
-        mblk->release();
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr (static_cast<size_t> (n));
+        OutPacket& out = m_OutQueue.front();
+        const size_t left = out.headerSize + out.buffer->GetSize () - out.sent;
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+        if (n < left)
         {
-            sLog.outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            out.sent += n;
+            return;
         }
 
-        return schedule_wakeup_output (g);
+        n -= left;
+        out.buffer->RemoveReference ();
+        m_OutQueue.pop_front ();
     }
-    else //now n == send_len
-    {
-        mblk->release();
-
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
-    }
-
-    ACE_NOTREACHED(return -1);
 }
 
 int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
@@ -454,7 +546,7 @@ int WorldSocket::Update (void)
     if (closing_)
         return -1;
 
-    if (m_OutActive || (m_OutBuffer->length () == 0 && msg_queue()->is_empty()))
+    if (m_OutActive || (m_OutBuffer->length () == 0 && m_OutQueue.empty()))
         return 0;
 
     int ret;
@@ -489,7 +581,7 @@ int WorldSocket::handle_input_header (void)
 
     header.size -= 4;
 
-    ACE_NEW_RETURN (m_RecvWPct, WorldPacket ((uint16) header.cmd, header.size), -1);
+    m_RecvWPct = AllocRecvPacket ((uint16) header.cmd, header.size);
 
     if(header.size > 0)
     {
@@ -674,7 +766,8 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
         return -1;
 
     // Dump received packet.
-    sLog.outWorldPacketDump(uint32(get_handle()), new_pct->GetOpcode(), LookupOpcodeName(new_pct->GetOpcode()), new_pct, true);
+    if (sLog.IsOutWorldPacketDump())
+        sLog.outWorldPacketDump(uint32(get_handle()), new_pct->GetOpcode(), LookupOpcodeName(new_pct->GetOpcode()), new_pct, true);
 
     try
     {
@@ -35,6 +35,7 @@
 #include <ace/Guard_T.h>
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
+#include <ace/Atomic_Op.h>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -43,10 +44,13 @@
 #include "Common.h"
 #include "Auth/AuthCrypt.h"
 #include "Auth/BigNumber.h"
+#include "MPSCQueue.h"
 
 class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
+class SharedPacket;
+class PacketBuffer;
 
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
@@ -61,7 +65,11 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  *
  * For output the class uses one buffer (64K usually) and
  * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
+ * the buffer. Queued packets are ref-counted PacketBuffers,
+ * so big packets sent to many players (SharedPacket) are
+ * only referenced by each socket queue, not copied, and are
+ * written together with the buffer by one writev call.
+ * The reason this is done, is because the server
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
@@ -116,6 +124,12 @@ class WorldSocket : protected WorldHandler
         /// @return -1 of failure
         int SendPacket (const WorldPacket& pct);
 
+        /// Same as above, but big packet body is queued by reference instead of copy.
+        int SendPacket (SharedPacket& pct);
+
+        /// Return processed incoming packet for reuse, can be called from any thread.
+        void RecycleRecvPacket (WorldPacket* packet);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -160,8 +174,15 @@ class WorldSocket : protected WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue (GuardType& g);
+        /// Put packet to the output buffer or the output queue.
+        /// @param shared not NULL if packet body can be referenced instead of copy
+        int SendPacket (const WorldPacket& pct, SharedPacket* shared);
+
+        /// Remove n sent bytes from the output buffer and the output queue.
+        void ConsumeOutput (size_t n);
+
+        /// Get packet for incoming data from the pool or allocate new one.
+        WorldPacket* AllocRecvPacket (uint16 opcode, size_t size);
 
         /// process one incoming packet.
         /// @param new_pct received packet ,note that you need to delete it.
@@ -195,6 +216,12 @@ class WorldSocket : protected WorldHandler
         /// here are stored the fragments of the received data
         WorldPacket* m_RecvWPct;
 
+        /// Processed incoming packets ready for reuse, filled by session update threads.
+        ACE_Based::MPSCQueue<WorldPacket*> m_RecvPacketPool;
+
+        /// Amount of packets in m_RecvPacketPool.
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_RecvPacketPoolSize;
+
         /// This block actually refers to m_RecvWPct contents,
         /// which allows easy and safe writing to it.
         /// It wont free memory when its deleted. m_RecvWPct takes care of freeing.
@@ -212,6 +239,28 @@ class WorldSocket : protected WorldHandler
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Packet waiting in the output queue.
+        struct OutPacket
+        {
+            /// Encrypted header, not used (size 0) if header copied into buffer.
+            uint8 header[5];
+            uint8 headerSize;
+
+            /// Packet body (or several packets with headers), one reference owned by queue.
+            PacketBuffer* buffer;
+
+            /// Already sent bytes of header + buffer.
+            size_t sent;
+        };
+
+        typedef std::deque<OutPacket> OutPacketQueue;
+
+        /// Packets that don't fit in m_OutBuffer, sent after it.
+        OutPacketQueue m_OutQueue;
+
+        /// Not sent bytes in m_OutQueue.
+        size_t m_OutQueueSize;
+
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
@@ -88,7 +88,10 @@ namespace Movement
         WorldPacket data(SMSG_MONSTER_MOVE, 64);
         data << unit.GetPackGUID();
         PacketBuilder::WriteMonsterMove(move_spline, data);
-        unit.SendMessageToSet(&data,true);
+        if (unit.GetTypeId() == TYPEID_PLAYER)
+            unit.SendMessageToSet(&data,true);
+        else
+            unit.SendMovementMessageToSetExcept(&data, NULL);
     }
 
     MoveSplineInit::MoveSplineInit(Unit& m) : unit(m)
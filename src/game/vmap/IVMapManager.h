@@ -41,6 +41,8 @@ namespace VMAP
     #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
     #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
+    #define VMAP_MAX_LOS_BATCH        32                    // max rays in one isInLineOfSight batch (bits of result mask)
+
     //===========================================================
     class IVMapManager
     {
@@ -61,6 +63,11 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            batched line of sight test, pCoords hold x1,y1,z1,x2,y2,z2 for each of pCount (<= VMAP_MAX_LOS_BATCH) rays
+            return mask with bit i set if ray i is not blocked
+            */
+            virtual uint32 isInLineOfSight(unsigned int pMapId, const float* pCoords, uint32 pCount) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
@@ -48,6 +48,15 @@ namespace VMAP
             bool hit;
     };
 
+    class MapBoxCallback
+    {
+        public:
+            MapBoxCallback(std::vector<uint32>& entries): entries(entries) {}
+            void operator()(uint32 entry) { entries.push_back(entry); }
+        protected:
+            std::vector<uint32>& entries;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -166,6 +175,53 @@ namespace VMAP
 
         return true;
     }
+
+    /**
+    Batched version of isInLineOfSight: the tree is traversed only once for the box enclosing
+    all rays, then every ray is tested against the collected model instances.
+    Return mask with bit i set if ray i is not blocked.
+    */
+    uint32 StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, uint32 count) const
+    {
+        MANGOS_ASSERT(count <= 32);
+        if (!count)
+            return 0;
+
+        G3D::AABox bounds(pos1[0].min(pos2[0]), pos1[0].max(pos2[0]));
+        for (uint32 i = 1; i < count; ++i)
+            bounds.merge(G3D::AABox(pos1[i].min(pos2[i]), pos1[i].max(pos2[i])));
+
+        std::vector<uint32> candidates;
+        MapBoxCallback boxCallback(candidates);
+        iTree.intersectBox(bounds, boxCallback);
+
+        uint32 result = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float maxDist = (pos2[i] - pos1[i]).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too:
+            MANGOS_ASSERT(maxDist < std::numeric_limits<float>::max());
+            bool visible = true;
+            if (maxDist >= 1e-10f)
+            {
+                G3D::Ray ray = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i])/maxDist);
+                for (std::vector<uint32>::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+                {
+                    float distance = maxDist;
+                    if (iTreeValues[*itr].intersectRay(ray, distance, true))
+                    {
+                        visible = false;
+                        break;
+                    }
+                }
+            }
+
+            if (visible)
+                result |= uint32(1) << i;
+        }
+
+        return result;
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
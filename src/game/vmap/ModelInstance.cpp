@@ -49,6 +49,9 @@ namespace VMAP
 #endif
             return false;
         }
+        // bounding box is entered behind the ray end
+        if (time > pMaxDist)
+            return false;
         // child bounds are defined in object space:
         Vector3 p = iInvRot * (pRay.origin() - iPos) * iInvScale;
         Ray modRay(p, iInvRot * pRay.direction());
@@ -169,6 +169,28 @@ namespace VMAP
         }
         return result;
     }
+
+    uint32 VMapManager2::isInLineOfSight(unsigned int pMapId, const float* pCoords, uint32 pCount)
+    {
+        MANGOS_ASSERT(pCount <= VMAP_MAX_LOS_BATCH);
+        uint32 allVisible = pCount < 32 ? (uint32(1) << pCount) - 1 : 0xFFFFFFFF;
+        if (!isLineOfSightCalcEnabled() || !pCount)
+            return allVisible;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return allVisible;
+
+        Vector3 pos1[VMAP_MAX_LOS_BATCH];
+        Vector3 pos2[VMAP_MAX_LOS_BATCH];
+        for (uint32 i = 0; i < pCount; ++i, pCoords += 6)
+        {
+            pos1[i] = convertPositionToInternalRep(pCoords[0], pCoords[1], pCoords[2]);
+            pos2[i] = convertPositionToInternalRep(pCoords[3], pCoords[4], pCoords[5]);
+        }
+
+        return instanceTree->second->isInLineOfSight(pos1, pos2, pCount);
+    }
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -86,6 +86,7 @@ namespace VMAP
             void unloadMap(unsigned int pMapId);
 
             bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) ;
+            uint32 isInLineOfSight(unsigned int pMapId, const float* pCoords, uint32 pCount);
             /**
             fill the hit pos and return true, if an object was hit
             */
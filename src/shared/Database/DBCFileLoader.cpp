@@ -21,52 +21,61 @@
 #include <string.h>
 
 #include "DBCFileLoader.h"
+#include "Errors.h"
+#include <ace/Mem_Map.h>
 
 DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
     fieldsOffset = NULL;
+    mapping = NULL;
 }
 
 bool DBCFileLoader::Load(const char *filename, const char *fmt)
 {
+    Unload();
 
-    uint32 header;
-    if(data)
+    // file is mapped copy-on-write: pages are shared with page cache until some code modify loaded entry
+    mapping = new ACE_Mem_Map();
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ | PROT_WRITE, ACE_MAP_PRIVATE) == -1)
     {
-        delete [] data;
-        data=NULL;
-    }
-
-    FILE * f=fopen(filename,"rb");
-    if(!f)return false;
-
-    if(fread(&header,4,1,f)!=1)                             // Number of records
+        Unload();
         return false;
+    }
 
-    EndianConvert(header);
-    if(header!=0x43424457)
-        return false;                                       //'WDBC'
-
-    if(fread(&recordCount,4,1,f)!=1)                        // Number of records
-        return false;
+    // mapping stays valid after file closing
+    mapping->close_handle();
 
-    EndianConvert(recordCount);
+    size_t fileSize = mapping->size();
+    unsigned char* fileData = static_cast<unsigned char*>(mapping->addr());
 
-    if(fread(&fieldCount,4,1,f)!=1)                         // Number of fields
+    uint32 header[5];
+    if (fileSize < sizeof(header))
+    {
+        Unload();
         return false;
+    }
 
-    EndianConvert(fieldCount);
+    memcpy(header, fileData, sizeof(header));
+    for (int i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if(fread(&recordSize,4,1,f)!=1)                         // Size of a record
+    if (header[0] != 0x43424457)                            //'WDBC'
+    {
+        Unload();
         return false;
+    }
 
-    EndianConvert(recordSize);
+    recordCount = header[1];                                // Number of records
+    fieldCount  = header[2];                                // Number of fields
+    recordSize  = header[3];                                // Size of a record
+    stringSize  = header[4];                                // String size
 
-    if(fread(&stringSize,4,1,f)!=1)                         // String size
+    if (uint64(recordSize) * recordCount + stringSize > uint64(fileSize - sizeof(header)))
+    {
+        Unload();
         return false;
-
-    EndianConvert(stringSize);
+    }
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -79,22 +88,53 @@ bool DBCFileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
+    data = fileData + sizeof(header);
     stringTable = data + recordSize*recordCount;
+    return true;
+}
 
-    if(fread(data,recordSize*recordCount+stringSize,1,f)!=1)
-        return false;
+void DBCFileLoader::Unload()
+{
+    delete mapping;                                         // unmap at destruction
+    mapping = NULL;
+    data = NULL;
 
-    fclose(f);
-    return true;
+    delete [] fieldsOffset;
+    fieldsOffset = NULL;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if(data)
-        delete [] data;
-    if(fieldsOffset)
-        delete [] fieldsOffset;
+    Unload();
+}
+
+ACE_Mem_Map* DBCFileLoader::ReleaseMapping()
+{
+    ACE_Mem_Map* released = mapping;
+    mapping = NULL;
+    return released;
+}
+
+void DBCFileLoader::FreeMapping(ACE_Mem_Map* mapping)
+{
+    delete mapping;
+}
+
+bool DBCFileLoader::IsInPlaceFormat(const char* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_BIGENDIAN
+    return false;                                           // values must be converted
+#else
+    if (strlen(format) != fieldCount)
+        return false;
+
+    // only fields with same size in file and in structure, and no skipped fields
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_IND && format[x] != FT_INT && format[x] != FT_FLOAT && format[x] != FT_BYTE)
+            return false;
+
+    return GetFormatRecordSize(format) == recordSize;
+#endif
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -241,14 +281,51 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
+char* DBCFileLoader::AutoProduceDataInPlace(const char* format, uint32& records, char**& indexTable)
+{
+    MANGOS_ASSERT(IsInPlaceFormat(format));
+
+    typedef char * ptr;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        //find max index
+        for(uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+                maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi*sizeof(ptr));
+
+        for(uint32 y = 0; y < recordCount; ++y)
+            indexTable[getRecord(y).getUInt(i)] = (char*)(data + y*recordSize);
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+
+        for(uint32 y = 0; y < recordCount; ++y)
+            indexTable[y] = (char*)(data + y*recordSize);
+    }
+
+    return (char*)data;
+}
+
 char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if(strlen(format)!=fieldCount)
         return NULL;
 
-    char* stringPool= new char[stringSize];
-    memcpy(stringPool,stringTable,stringSize);
-
     uint32 offset=0;
 
     for(uint32 y =0; y < recordCount; ++y)
@@ -273,8 +350,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if(!*slot || !**slot)
                     {
-                        const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
                     offset += sizeof(char*);
                     break;
@@ -293,5 +369,5 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return (char*)stringTable;
 }
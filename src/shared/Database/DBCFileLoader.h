@@ -22,6 +22,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 enum
 {
     FT_NA='x',                                              //not used or unknown, 4 byte size
@@ -41,6 +43,7 @@ class DBCFileLoader
         DBCFileLoader();
         ~DBCFileLoader();
 
+        // map file copy-on-write, records and strings are used directly from mapping
         bool Load(const char *filename, const char *fmt);
 
         class Record
@@ -92,9 +95,21 @@ class DBCFileLoader
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() {return (data!=NULL);}
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable);
+        // return records data inside mapping instead of copy, allowed only for IsInPlaceFormat formats
+        char* AutoProduceDataInPlace(const char* fmt, uint32& count, char**& indexTable);
+        // string fields point to string table inside mapping, returned pointer is not owned
         char* AutoProduceStrings(const char* fmt, char* dataTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
+
+        // format describes structure with same layout as file record (no strings, skipped or sort fields)
+        bool IsInPlaceFormat(const char* fmt) const;
+
+        // produced data may point into mapping, so owner of produced data must take and keep mapping
+        ACE_Mem_Map* ReleaseMapping();
+        static void FreeMapping(ACE_Mem_Map* mapping);
     private:
+        void Unload();
+
 
         uint32 recordSize;
         uint32 recordCount;
@@ -103,5 +118,6 @@ class DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        ACE_Mem_Map* mapping;
 };
 #endif
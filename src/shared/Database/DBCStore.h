@@ -24,9 +24,9 @@
 template<class T>
 class DBCStorage
 {
-    typedef std::list<char*> StringPoolList;
+    typedef std::list<ACE_Mem_Map*> MappingList;
     public:
-        explicit DBCStorage(const char *f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL) { }
+        explicit DBCStorage(const char *f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL), m_dataInPlace(false) { }
         ~DBCStorage() { Clear(); }
 
         T const* LookupEntry(uint32 id) const { return (id>=nCount)?NULL:indexTable[id]; }
@@ -43,11 +43,16 @@ class DBCStorage
 
             fieldCount = dbc.GetCols();
 
-            // load raw non-string data
-            m_dataTable = (T*)dbc.AutoProduceData(fmt,nCount,(char**&)indexTable);
+            // use records directly from file mapping if structure layout is same, else load raw non-string data
+            m_dataInPlace = dbc.IsInPlaceFormat(fmt);
+            if (m_dataInPlace)
+                m_dataTable = (T*)dbc.AutoProduceDataInPlace(fmt,nCount,(char**&)indexTable);
+            else
+                m_dataTable = (T*)dbc.AutoProduceData(fmt,nCount,(char**&)indexTable);
 
-            // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable));
+            // load strings from dbc data, they are referenced in mapping
+            dbc.AutoProduceStrings(fmt,(char*)m_dataTable);
+            m_mappingList.push_back(dbc.ReleaseMapping());
 
             // error in dbc file at loading if NULL
             return indexTable!=NULL;
@@ -64,8 +69,9 @@ class DBCStorage
             if(!dbc.Load(fn, fmt))
                 return false;
 
-            // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable));
+            // load strings from another locale dbc data, mapping of locale file is kept for them
+            dbc.AutoProduceStrings(fmt,(char*)m_dataTable);
+            m_mappingList.push_back(dbc.ReleaseMapping());
 
             return true;
         }
@@ -77,13 +83,14 @@ class DBCStorage
 
             delete[] ((char*)indexTable);
             indexTable = NULL;
-            delete[] ((char*)m_dataTable);
+            if (!m_dataInPlace)
+                delete[] ((char*)m_dataTable);
             m_dataTable = NULL;
 
-            while(!m_stringPoolList.empty())
+            while(!m_mappingList.empty())
             {
-                delete[] m_stringPoolList.front();
-                m_stringPoolList.pop_front();
+                DBCFileLoader::FreeMapping(m_mappingList.front());
+                m_mappingList.pop_front();
             }
             nCount = 0;
         }
@@ -96,7 +103,8 @@ class DBCStorage
         char const* fmt;
         T** indexTable;
         T* m_dataTable;
-        StringPoolList m_stringPoolList;
+        bool m_dataInPlace;                                 // m_dataTable points into first mapping
+        MappingList m_mappingList;
 };
 
 #endif
@@ -43,6 +43,11 @@ void SqlConnection::FreePreparedStatements()
         delete m_holder[i];
 
     m_holder.clear();
+
+    for (size_t i = 0; i < m_batchHolder.size(); ++i)
+        delete m_batchHolder[i].m_pValues;
+
+    m_batchHolder.clear();
 }
 
 SqlPreparedStatement * SqlConnection::GetStmt( int nIndex )
@@ -93,13 +98,120 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id )
     return pStmt->execute();
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id )
+{
+    if(nIndex == -1)
+        return NULL;
+
+    SqlPreparedStatement * pStmt = GetStmt(nIndex);
+    if(!pStmt)
+        return NULL;
+
+    pStmt->bind(id);
+    return pStmt->query();
+}
+
+//split "INSERT INTO t (a, b) VALUES (?, ?)" to "INSERT INTO t (a, b) VALUES " and "(?, ?)"
+//return false if statement is not single row INSERT with all parameters in VALUES list
+static bool SplitInsertStatement(const std::string& fmt, std::string& prefix, std::string& values)
+{
+    if (strnicmp(fmt.c_str(), "insert", 6) != 0)
+        return false;
+
+    std::string upper(fmt);
+    std::transform(upper.begin(), upper.end(), upper.begin(), toupper);
+
+    size_t pos = upper.rfind("VALUES");
+    if (pos == std::string::npos)
+        return false;
+
+    size_t start = fmt.find_first_not_of(" \t\r\n", pos + 6);
+    size_t end = fmt.find_last_not_of(" \t\r\n;");
+    if (start == std::string::npos || end == std::string::npos || fmt[start] != '(' || fmt[end] != ')')
+        return false;
+
+    //VALUES list must be one top level group, parameters only inside it
+    int depth = 0;
+    for (size_t i = start; i <= end; ++i)
+    {
+        if (fmt[i] == '(')
+            ++depth;
+        else if (fmt[i] == ')' && --depth == 0 && i != end)
+            return false;
+    }
+
+    prefix = fmt.substr(0, start);
+    if (prefix.find('?') != std::string::npos)
+        return false;
+
+    values = fmt.substr(start, end - start + 1);
+    return true;
+}
+
+SqlPlainPreparedStatement * SqlConnection::GetBatchStmt( int nIndex )
+{
+    if(nIndex < 0)
+        return NULL;
+
+    if(m_batchHolder.size() <= size_t(nIndex))
+        m_batchHolder.resize(nIndex + 1);
+
+    BatchStmt& batch = m_batchHolder[nIndex];
+    if(!batch.m_bInitialized)
+    {
+        batch.m_bInitialized = true;
+
+        std::string values;
+        if(SplitInsertStatement(m_db.GetStmtString(nIndex), batch.m_szPrefix, values))
+            batch.m_pValues = new SqlPlainPreparedStatement(values, *this);
+    }
+
+    return batch.m_pValues;
+}
+
+bool SqlConnection::ExecuteStmtBatch(int nIndex, const SqlStmtParameters * const * params, size_t nCount)
+{
+    SqlPlainPreparedStatement * pValues = nCount > 1 ? GetBatchStmt(nIndex) : NULL;
+    if(!pValues)
+    {
+        for (size_t i = 0; i < nCount; ++i)
+            if(!ExecuteStmt(nIndex, *params[i]))
+                return false;
+
+        return true;
+    }
+
+    const std::string& prefix = m_batchHolder[nIndex].m_szPrefix;
+
+    std::string sql;
+    for (size_t i = 0; i < nCount; )
+    {
+        sql = prefix;
+
+        //limit request size, one row is added always
+        for (size_t nRows = 0; i < nCount && (nRows == 0 || sql.length() < MAX_QUERY_LEN); ++i, ++nRows)
+        {
+            pValues->bind(*params[i]);
+
+            if(nRows > 0)
+                sql += ',';
+            sql += pValues->plainRequest();
+        }
+
+        if(!Execute(sql.c_str()))
+            return false;
+    }
+
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char * infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -136,10 +248,25 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    //create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if(!m_pAsyncConn->Initialize(infoString))
-        return false;
+    //create and initialize connections for async requests
+    if(nAsyncConns < MIN_CONNECTION_POOL_SIZE)
+        nAsyncConns = MIN_CONNECTION_POOL_SIZE;
+    else if(nAsyncConns > MAX_CONNECTION_POOL_SIZE)
+        nAsyncConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection * pConn = CreateConnection();
+        if(!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
+    }
+
+    m_pAsyncConn = m_pAsyncConnections[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -157,11 +284,11 @@ void Database::StopServer()
         m_pResultQueue = NULL;
     }
 
-    if(m_pAsyncConn)
-    {
-        delete m_pAsyncConn;
-        m_pAsyncConn = NULL;
-    }
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+        delete m_pAsyncConnections[i];
+
+    m_pAsyncConnections.clear();
+    m_pAsyncConn = NULL;
 
     for (size_t i = 0; i < m_pQueryConnections.size(); ++i)
         delete m_pQueryConnections[i];
@@ -170,30 +297,92 @@ void Database::StopServer()
 
 }
 
-SqlDelayThread * Database::CreateDelayThread()
+SqlDelayThread * Database::CreateDelayThread(SqlConnection * conn)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    //only first thread ping DB, Ping() touch all connections
+    return new SqlDelayThread(this, conn, conn == m_pAsyncConn);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
 
-    //New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new ACE_Based::Thread(m_threadBody);
+    //New delay thread for delay execute, one for each async connection
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        SqlDelayThread * pBody = CreateDelayThread(m_pAsyncConnections[i]);    // will deleted at thread delete
+        m_threadBodies.push_back(pBody);
+        m_delayThreads.push_back(new ACE_Based::Thread(pBody));
+    }
+
+    m_bWaitSerial.assign(m_threadBodies.size(), false);
+    m_bSignalSerial.assign(m_threadBodies.size(), false);
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_delayThreads.empty()) return;
+
+    //threads must be stopped one by one: requests left in queue of stopped thread
+    //can wait for requests of other threads, so those must be still running
+    for (size_t i = 0; i < m_delayThreads.size(); ++i)
+    {
+        m_threadBodies[i]->Stop();                          //Stop event
+        m_delayThreads[i]->wait();                          //Wait for flush to DB
+        delete m_delayThreads[i];                           //This also deletes thread body
+    }
 
-    m_threadBody->Stop();                                   //Stop event
-    m_delayThread->wait();                                  //Wait for flush to DB
-    delete m_delayThread;                                   //This also deletes m_threadBody
-    m_delayThread = NULL;
-    m_threadBody = NULL;
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+bool Database::DelayOperation(SqlOperation * op, uint32 serialId /*= 0*/)
+{
+    //single async connection, all requests executed in queue order
+    if(m_threadBodies.size() == 1)
+        return m_threadBodies[0]->Delay(op);
+
+    LOCK_GUARD _guard(m_delayGuard);
+
+    if(serialId)
+    {
+        //requests with same serial id are executed by same thread in queue order...
+        size_t nThread = 1 + serialId % (m_threadBodies.size() - 1);
+
+        //...and after all requests without serial id queued before them
+        if(m_bWaitSerial[nThread])
+        {
+            SqlSyncPoint * pPoint = new SqlSyncPoint(1);
+            m_threadBodies[0]->Delay(new SqlSyncRequest(pPoint, false));
+            m_threadBodies[nThread]->Delay(new SqlSyncRequest(pPoint, true));
+            m_bWaitSerial[nThread] = false;
+        }
+
+        m_bSignalSerial[nThread] = true;
+        return m_threadBodies[nThread]->Delay(op);
+    }
+
+    //requests without serial id are executed by first thread in queue order
+    //and after all requests queued before them to other threads
+    int nSignals = std::count(m_bSignalSerial.begin(), m_bSignalSerial.end(), true);
+    if(nSignals)
+    {
+        SqlSyncPoint * pPoint = new SqlSyncPoint(nSignals);
+        for (size_t i = 1; i < m_threadBodies.size(); ++i)
+        {
+            if(m_bSignalSerial[i])
+            {
+                m_threadBodies[i]->Delay(new SqlSyncRequest(pPoint, false));
+                m_bSignalSerial[i] = false;
+            }
+        }
+
+        m_threadBodies[0]->Delay(new SqlSyncRequest(pPoint, true));
+    }
+
+    std::fill(m_bWaitSerial.begin() + 1, m_bWaitSerial.end(), true);
+    return m_threadBodies[0]->Delay(op);
 }
 
 void Database::ThreadStart()
@@ -238,8 +427,9 @@ void Database::Ping()
 {
     const char * sql = "SELECT 1";
 
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConnections[i]);
         delete guard->Query(sql);
     }
 
@@ -350,7 +540,7 @@ bool Database::Execute(const char *sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayOperation(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -396,14 +586,14 @@ bool Database::DirectPExecute(const char * format,...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 serialId /*= 0*/)
 {
     if (!m_pAsyncConn)
         return false;
 
     //initiate transaction on current thread
     //currently we do not support queued transactions
-    m_TransStorage->init();
+    m_TransStorage->init(serialId);
     return true;
 }
 
@@ -421,8 +611,8 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     //add SqlTransaction to the async queue
-    m_threadBody->Delay(m_TransStorage->detach());
-    return true;
+    SqlTransaction * pTrans = m_TransStorage->detach();
+    return DelayOperation(pTrans, pTrans->GetSerialId());
 }
 
 bool Database::CommitTransactionDirect()
@@ -562,7 +752,7 @@ bool Database::ExecuteStmt( const SqlStatementID& id, SqlStmtParameters * params
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayOperation(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -577,6 +767,14 @@ bool Database::DirectExecuteStmt( const SqlStatementID& id, SqlStmtParameters *
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt( const SqlStatementID& id, SqlStmtParameters * params )
+{
+    MANGOS_ASSERT(params);
+    std::auto_ptr<SqlStmtParameters> p(params);
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char * fmt )
 {
     int nId = -1;
@@ -628,10 +826,10 @@ Database::TransHelper::~TransHelper()
     reset();
 }
 
-SqlTransaction * Database::TransHelper::init()
+SqlTransaction * Database::TransHelper::init(uint32 serialId)
 {
     MANGOS_ASSERT(!m_pTrans);   //if we will get a nested transaction request - we MUST fix code!!!
-    m_pTrans = new SqlTransaction;
+    m_pTrans = new SqlTransaction(serialId);
     return m_pTrans;
 }
 
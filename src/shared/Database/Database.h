@@ -63,6 +63,9 @@ class MANGOS_DLL_SPEC SqlConnection
 
         //methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
+        //execute same statement for several parameter sets, single row INSERT is executed as one multi-row INSERT
+        bool ExecuteStmtBatch(int nIndex, const SqlStmtParameters * const * params, size_t nCount);
 
         //SqlConnection object lock
         class Lock
@@ -93,11 +96,26 @@ class MANGOS_DLL_SPEC SqlConnection
         void FreePreparedStatements();
 
     private:
+        //get VALUES part of INSERT statement for multi-row execution, NULL if statement can't be batched
+        SqlPlainPreparedStatement * GetBatchStmt(int nIndex);
+
         typedef ACE_Recursive_Thread_Mutex LOCK_TYPE;
         LOCK_TYPE m_mutex;
 
         typedef std::vector<SqlPreparedStatement * > StmtHolder;
         StmtHolder m_holder;
+
+        struct BatchStmt
+        {
+            BatchStmt() : m_bInitialized(false), m_pValues(NULL) {}
+
+            bool m_bInitialized;
+            std::string m_szPrefix;                             //"INSERT INTO table (fields) VALUES "
+            SqlPlainPreparedStatement * m_pValues;              //"(?, ?)" part, NULL if statement can't be batched
+        };
+
+        typedef std::vector<BatchStmt> BatchStmtHolder;
+        BatchStmtHolder m_batchHolder;
 };
 
 class MANGOS_DLL_SPEC Database
@@ -105,10 +123,11 @@ class MANGOS_DLL_SPEC Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char *infoString, int nConns = 1);
-        //start worker thread for async DB request execution
+        //nConns - connections for sync queries, nAsyncConns - connections (each with own worker thread) for async requests
+        virtual bool Initialize(const char *infoString, int nConns = 1, int nAsyncConns = 1);
+        //start worker threads for async DB request execution
         virtual void InitDelayThread();
-        //stop worker thread
+        //stop worker threads
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -184,7 +203,9 @@ class MANGOS_DLL_SPEC Database
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char *format,...) ATTR_PRINTF(2,3);
 
-        bool BeginTransaction();
+        //transactions with non-zero serial id (character guid, account id, ...) can be executed concurrently
+        //with transactions of other serial ids, but only after all async requests without serial id queued before
+        bool BeginTransaction(uint32 serialId = 0);
         bool CommitTransaction();
         bool RollbackTransaction();
         //for sync transaction execution
@@ -222,7 +243,7 @@ class MANGOS_DLL_SPEC Database
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
 
     protected:
-        Database() : m_pAsyncConn(NULL), m_pResultQueue(NULL), m_threadBody(NULL), m_delayThread(NULL),
+        Database() : m_pAsyncConn(NULL), m_pResultQueue(NULL),
             m_logSQL(false), m_pingIntervallms(0), m_nQueryConnPoolSize(1), m_bAllowAsyncTransactions(false), m_iStmtIndex(-1)
         {
             m_nQueryCounter = -1;
@@ -233,7 +254,7 @@ class MANGOS_DLL_SPEC Database
         //factory method to create SqlConnection objects
         virtual SqlConnection * CreateConnection() = 0;
         //factory method to create SqlDelayThread objects
-        virtual SqlDelayThread * CreateDelayThread();
+        virtual SqlDelayThread * CreateDelayThread(SqlConnection * conn);
 
         class MANGOS_DLL_SPEC TransHelper
         {
@@ -242,7 +263,7 @@ class MANGOS_DLL_SPEC Database
                 ~TransHelper();
 
                 //initializes new SqlTransaction object
-                SqlTransaction * init();
+                SqlTransaction * init(uint32 serialId);
                 //gets pointer on current transaction object. Returns NULL if transaction was not initiated
                 SqlTransaction * get() const { return m_pTrans; }
                 //detaches SqlTransaction object allocated by init() function
@@ -268,10 +289,17 @@ class MANGOS_DLL_SPEC Database
         SqlConnection * getAsyncConnection() const { return m_pAsyncConn; }
 
         friend class SqlStatement;
+        friend class SqlQueryHolder;
+
+        //queue async request to worker thread of async connection selected by serial id
+        bool DelayOperation(SqlOperation * op, uint32 serialId = 0);
+
         //PREPARED STATEMENT API
         //query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters * params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters * params);
+        //sync query function for prepared statements
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters * params);
 
         //connection helper counters
         int m_nQueryConnPoolSize;                               //current size of query connection pool
@@ -281,12 +309,21 @@ class MANGOS_DLL_SPEC Database
         typedef std::vector< SqlConnection * > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        //only one single DB connection for transactions
+        //DB connection for sync transactions and async requests without serial id
         SqlConnection * m_pAsyncConn;
+        //all connections for async requests, first one is m_pAsyncConn
+        SqlConnectionContainer m_pAsyncConnections;
+
+        typedef std::vector<SqlDelayThread * > DelayThreadBodies;
+        typedef std::vector<ACE_Based::Thread * > DelayThreads;
 
         SqlResultQueue *    m_pResultQueue;                  ///< Transaction queues from diff. threads
-        SqlDelayThread *    m_threadBody;                    ///< Pointer to delay sql executer (owned by m_delayThread)
-        ACE_Based::Thread * m_delayThread;                   ///< Pointer to executer thread
+        DelayThreadBodies   m_threadBodies;                  ///< Delay sql executers, one for each async connection (owned by m_delayThreads)
+        DelayThreads        m_delayThreads;                  ///< Executer threads
+
+        //ordering of requests between delay threads, protected by m_delayGuard
+        std::vector<bool>   m_bWaitSerial;                   ///< thread must wait for first thread before executing next request
+        std::vector<bool>   m_bSignalSerial;                 ///< first thread must wait for thread before executing next request
 
         bool m_bAllowAsyncTransactions;                      ///< flag which specifies if async transactions are enabled
 
@@ -295,6 +332,7 @@ class MANGOS_DLL_SPEC Database
         typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
 
         mutable LOCK_TYPE m_stmtGuard;
+        LOCK_TYPE m_delayGuard;
 
         typedef UNORDERED_MAP<std::string, int> PreparedStmtRegistry;
         PreparedStmtRegistry m_stmtRegistry;                 ///<
@@ -377,7 +377,9 @@ bool MySqlPreparedStatement::prepare()
         /* Get total columns in the query */
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
-        //bind output buffers
+        //output buffers are bound at query() after result store, string buffers depend on max length of values
+        my_bool bUpdateMaxLength = 1;
+        mysql_stmt_attr_set(m_stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &bUpdateMaxLength);
     }
 
     m_bPrepared = true;
@@ -473,6 +475,55 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResult* MySqlPreparedStatement::query()
+{
+    if(!isPrepared())
+        return NULL;
+
+    if(!isQuery())
+    {
+        sLog.outError("SQL: '%s' is not a query", m_szFmt.c_str());
+        return NULL;
+    }
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    if(mysql_stmt_execute(m_stmt) || mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outErrorDb("SQL: %s", m_szFmt.c_str());
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(m_stmt));
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s,WorldTimer::getMSTime()), m_szFmt.c_str());
+
+    uint64 rowCount = mysql_stmt_num_rows(m_stmt);
+    if(!rowCount)
+    {
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    //metadata with max_length updated by mysql_stmt_store_result()
+    MYSQL_RES * metadata = mysql_stmt_result_metadata(m_stmt);
+
+    QueryResultMysqlStmt * queryResult = new QueryResultMysqlStmt(rowCount, m_nColumns);
+    bool bFetched = metadata && queryResult->FetchRows(m_stmt, mysql_fetch_fields(metadata));
+
+    mysql_free_result(metadata);
+    mysql_stmt_free_result(m_stmt);
+
+    if(!bFetched || !queryResult->GetRowCount())
+    {
+        delete queryResult;
+        return NULL;
+    }
+
+    queryResult->NextRow();
+    return queryResult;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType( const SqlStmtFieldData &data, my_bool &bUnsigned )
 {
     bUnsigned = 0;
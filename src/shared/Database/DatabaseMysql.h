@@ -50,6 +50,9 @@ public:
     //execute DML statement
     virtual bool execute();
 
+    //execute SELECT statement, rows are received by binary protocol
+    virtual QueryResult* query();
+
 protected:
     //bind parameters
     void addParam(int nIndex, const SqlStmtFieldData& data);
@@ -16,5 +16,20 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-//#include "DatabaseEnv.h"
+#include "Field.h"
+
+void Field::FormatBinaryValue() const
+{
+    switch (mBinaryType)
+    {
+        case DB_BINARY_INT64:  snprintf(mText, sizeof(mText), SI64FMTD, mBinary.i64); break;
+        case DB_BINARY_UINT64: snprintf(mText, sizeof(mText), UI64FMTD, mBinary.ui64); break;
+        // same precision as text protocol output of FLOAT/DOUBLE columns
+        case DB_BINARY_FLOAT:  snprintf(mText, sizeof(mText), "%.6g", mBinary.d); break;
+        case DB_BINARY_DOUBLE: snprintf(mText, sizeof(mText), "%.15g", mBinary.d); break;
+        default:               mText[0] = '\0'; break;
+    }
+
+    mTextReady = true;
+}
 
@@ -34,28 +34,64 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        //format of numeric values received by binary protocol (prepared statement results)
+        enum BinaryTypes
+        {
+            DB_BINARY_NONE   = 0x00,                        // value is text, see mValue
+            DB_BINARY_INT64  = 0x01,
+            DB_BINARY_UINT64 = 0x02,
+            DB_BINARY_FLOAT  = 0x03,
+            DB_BINARY_DOUBLE = 0x04
+        };
+
+        union BinaryValue
+        {
+            int64 i64;
+            uint64 ui64;
+            double d;
+        };
+
+        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN), mBinaryType(DB_BINARY_NONE), mTextReady(false) { mBinary.ui64 = 0; }
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mBinaryType(DB_BINARY_NONE), mTextReady(false) { mBinary.ui64 = 0; }
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
         bool IsNULL() const { return mValue == NULL; }
 
-        const char *GetString() const { return mValue; }
+        const char *GetString() const
+        {
+            if (mBinaryType != DB_BINARY_NONE && mValue && !mTextReady)
+                FormatBinaryValue();
+            return mValue;
+        }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
+        }
+        float GetFloat() const
+        {
+            if (mBinaryType != DB_BINARY_NONE)
+                return GetBinary<float>();
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        bool GetBool() const
+        {
+            if (mBinaryType != DB_BINARY_NONE)
+                return GetBinary<int64>() > 0;
+            return mValue ? atoi(mValue) > 0 : false;
+        }
+        int32 GetInt32() const { return mBinaryType != DB_BINARY_NONE ? GetBinary<int32>() : mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        uint8 GetUInt8() const { return mBinaryType != DB_BINARY_NONE ? GetBinary<uint8>() : mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint16 GetUInt16() const { return mBinaryType != DB_BINARY_NONE ? GetBinary<uint16>() : mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        int16 GetInt16() const { return mBinaryType != DB_BINARY_NONE ? GetBinary<int16>() : mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        uint32 GetUInt32() const { return mBinaryType != DB_BINARY_NONE ? GetBinary<uint32>() : mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
         uint64 GetUInt64() const
         {
+            if (mBinaryType != DB_BINARY_NONE)
+                return GetBinary<uint64>();
+
             uint64 value = 0;
             if(!mValue || sscanf(mValue,UI64FMTD,&value) == -1)
                 return 0;
@@ -66,13 +102,42 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         //no need for memory allocations to store resultset field strings
         //all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; };
+        void SetValue(const char* value) { mValue = value; mBinaryType = DB_BINARY_NONE; };
+        //numeric value already converted by DBMS client library, text form is created only at GetString() call
+        void SetBinaryValue(BinaryValue value, enum BinaryTypes type, bool isNull)
+        {
+            mBinary = value;
+            mBinaryType = type;
+            mTextReady = false;
+            mValue = isNull ? NULL : mText;
+        }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
+        template<typename T>
+        T GetBinary() const
+        {
+            if (!mValue)
+                return T(0);
+
+            switch (mBinaryType)
+            {
+                case DB_BINARY_UINT64: return static_cast<T>(mBinary.ui64);
+                case DB_BINARY_FLOAT:
+                case DB_BINARY_DOUBLE: return static_cast<T>(mBinary.d);
+                default:               return static_cast<T>(mBinary.i64);
+            }
+        }
+
+        void FormatBinaryValue() const;
+
         const char* mValue;
         enum DataTypes mType;
+        enum BinaryTypes mBinaryType;
+        BinaryValue mBinary;
+        mutable bool mTextReady;
+        mutable char mText[32];
 };
 #endif
@@ -72,7 +72,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -102,4 +102,128 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+//////////////////////////////////////////////////////////////////////////
+QueryResultMysqlStmt::QueryResultMysqlStmt(uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mBinaryTypes(fieldCount, Field::DB_BINARY_NONE), mNextRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    delete [] mCurrentRow;
+}
+
+bool QueryResultMysqlStmt::FetchRows(MYSQL_STMT *stmt, MYSQL_FIELD *fields)
+{
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<Field::BinaryValue> binary(mFieldCount);
+    std::vector<my_bool> isNull(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::vector<size_t> textOffset(mFieldCount);
+
+    //text columns are fetched into one buffer, max_length is known after mysql_stmt_store_result()
+    size_t textSize = 0;
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        textOffset[i] = textSize;
+        textSize += fields[i].max_length + 1;
+    }
+    std::vector<char> text(textSize);
+
+    memset(&binds[0], 0, sizeof(MYSQL_BIND) * mFieldCount);
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+
+        MYSQL_BIND& bind = binds[i];
+        bind.is_null = &isNull[i];
+        bind.length = &lengths[i];
+
+        switch (fields[i].type)
+        {
+            case FIELD_TYPE_TINY:
+            case FIELD_TYPE_SHORT:
+            case FIELD_TYPE_LONG:
+            case FIELD_TYPE_INT24:
+            case FIELD_TYPE_LONGLONG:
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) ? 1 : 0;
+                bind.buffer = &binary[i];
+                mBinaryTypes[i] = bind.is_unsigned ? Field::DB_BINARY_UINT64 : Field::DB_BINARY_INT64;
+                break;
+            case FIELD_TYPE_FLOAT:
+            case FIELD_TYPE_DOUBLE:
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &binary[i];
+                mBinaryTypes[i] = fields[i].type == FIELD_TYPE_FLOAT ? Field::DB_BINARY_FLOAT : Field::DB_BINARY_DOUBLE;
+                break;
+            default:
+                //strings, decimals and dates are received in same form as by text protocol
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &text[textOffset[i]];
+                bind.buffer_length = fields[i].max_length + 1;
+                break;
+        }
+    }
+
+    if (mysql_stmt_bind_result(stmt, &binds[0]))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        return false;
+    }
+
+    mValues.reserve(size_t(mRowCount) * mFieldCount);
+
+    int res;
+    while ((res = mysql_stmt_fetch(stmt)) == 0)
+    {
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            Value value;
+            value.binary = binary[i];
+            value.isNull = isNull[i] != 0;
+            value.text = mText.size();
+
+            if (mBinaryTypes[i] == Field::DB_BINARY_NONE)
+            {
+                if (!value.isNull)
+                    mText.insert(mText.end(), text.begin() + textOffset[i], text.begin() + textOffset[i] + lengths[i]);
+                mText.push_back('\0');
+            }
+
+            mValues.push_back(value);
+        }
+    }
+
+    if (res != MYSQL_NO_DATA)
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_fetch() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        return false;
+    }
+
+    mRowCount = mFieldCount ? mValues.size() / mFieldCount : 0;
+    return true;
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (mNextRow >= mRowCount)
+        return false;
+
+    const Value* row = &mValues[size_t(mNextRow) * mFieldCount];
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        if (mBinaryTypes[i] != Field::DB_BINARY_NONE)
+            mCurrentRow[i].SetBinaryValue(row[i].binary, mBinaryTypes[i], row[i].isNull);
+        else
+            mCurrentRow[i].SetValue(row[i].isNull ? NULL : &mText[row[i].text]);
+    }
+
+    ++mNextRow;
+    return true;
+}
 #endif
@@ -39,11 +39,39 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow();
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES *mResult;
 };
+
+//result of prepared statement received by binary protocol, numeric values are not converted from text
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        QueryResultMysqlStmt(uint64 rowCount, uint32 fieldCount);
+
+        ~QueryResultMysqlStmt();
+
+        //copy all rows of executed statement with stored result, statement result can be freed after it
+        bool FetchRows(MYSQL_STMT *stmt, MYSQL_FIELD *fields);
+
+        bool NextRow();
+
+    private:
+        struct Value
+        {
+            Field::BinaryValue binary;
+            size_t text;                                    // offset in mText for text columns
+            bool isNull;
+        };
+
+        std::vector<Field::BinaryTypes> mBinaryTypes;       // DB_BINARY_NONE for columns received as text
+        std::vector<Value> mValues;                         // mRowCount * mFieldCount values
+        std::vector<char> mText;                            // zero terminated values of text columns
+        uint64 mNextRow;
+};
 #endif
 #endif
@@ -21,6 +21,14 @@
 
 void SQLStorage::EraseEntry(uint32 id)
 {
+    if (id >= MaxEntry)
+        return;
+
+    // GetRecord, not LookupEntry: record with id 0 is visited by iterators and must be freed too
+    char const* record = GetRecord(id);
+    if (!record)
+        return;
+
     uint32 offset = 0;
     for(uint32 x = 0; x < iNumFields; ++x)
     {
@@ -36,8 +44,7 @@ void SQLStorage::EraseEntry(uint32 id)
                 offset += sizeof(float);  break;
             case FT_STRING:
             {
-                if(pIndex[id])
-                    delete [] *(char**)((char*)(pIndex[id])+offset);
+                delete [] *(char**)(record+offset);
 
                 offset += sizeof(char*);
                 break;
@@ -55,7 +62,7 @@ void SQLStorage::EraseEntry(uint32 id)
         }
     }
 
-    pIndex[id] = NULL;
+    pIndex[id >> INDEX_BLOCK_BITS][id & INDEX_BLOCK_MASK] = NULL;
 }
 
 void SQLStorage::Free ()
@@ -75,9 +82,8 @@ void SQLStorage::Free ()
                 offset += sizeof(float);  break;
             case FT_STRING:
             {
-                for(uint32 y = 0; y < MaxEntry; ++y)
-                    if(pIndex[y])
-                        delete [] *(char**)((char*)(pIndex[y])+offset);
+                for(const_iterator<char> itr = begin<char>(); itr != end<char>(); ++itr)
+                    delete [] *(char**)(*itr+offset);
 
                 offset += sizeof(char*);
                 break;
@@ -95,10 +101,63 @@ void SQLStorage::Free ()
         }
     }
 
-    delete [] pIndex;
+    FreeIndex(pIndex, MaxEntry);
     delete [] data;
 }
 
+uint32 SQLStorage::NextEntry(uint32 id) const
+{
+    for (++id; id < MaxEntry;)
+    {
+        char** block = pIndex[id >> INDEX_BLOCK_BITS];
+        if (!block)
+        {
+            id = (id | INDEX_BLOCK_MASK) + 1;               // skip whole empty block
+            continue;
+        }
+
+        if (block[id & INDEX_BLOCK_MASK])
+            return id;
+
+        ++id;
+    }
+
+    return MaxEntry;
+}
+
+char*** SQLStorage::CreateIndex(uint32 maxEntry)
+{
+    uint32 blocks = (maxEntry + INDEX_BLOCK_MASK) >> INDEX_BLOCK_BITS;
+
+    char*** index = new char**[blocks];
+    memset(index, 0, blocks * sizeof(char**));
+    return index;
+}
+
+void SQLStorage::SetIndexEntry(char*** index, uint32 id, char* record)
+{
+    char**& block = index[id >> INDEX_BLOCK_BITS];
+    if (!block)
+    {
+        block = new char*[INDEX_BLOCK_SIZE];
+        memset(block, 0, INDEX_BLOCK_SIZE * sizeof(char*));
+    }
+
+    block[id & INDEX_BLOCK_MASK] = record;
+}
+
+void SQLStorage::FreeIndex(char*** index, uint32 maxEntry)
+{
+    if (!index)
+        return;
+
+    uint32 blocks = (maxEntry + INDEX_BLOCK_MASK) >> INDEX_BLOCK_BITS;
+    for (uint32 i = 0; i < blocks; ++i)
+        delete [] index[i];
+
+    delete [] index;
+}
+
 void SQLStorage::Load()
 {
     SQLStorageLoader loader;
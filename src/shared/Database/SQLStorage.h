@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
 
+class ByteBuffer;
+
 class SQLStorage
 {
     template<class T>
@@ -56,9 +58,37 @@ class SQLStorage
                 return NULL;
             if(id >= MaxEntry)
                 return NULL;
-            return reinterpret_cast<T const*>(pIndex[id]);
+            char** block = pIndex[id >> INDEX_BLOCK_BITS];
+            return block ? reinterpret_cast<T const*>(block[id & INDEX_BLOCK_MASK]) : NULL;
         }
 
+        // forward iterator over existed entries in entry id order, not visit empty index blocks
+        template<class T>
+        class const_iterator
+        {
+            public:
+                const_iterator(SQLStorage const& storage, uint32 id) : m_storage(&storage), m_id(id) {}
+
+                T const* operator*() const { return reinterpret_cast<T const*>(m_storage->GetRecord(m_id)); }
+                T const* operator->() const { return reinterpret_cast<T const*>(m_storage->GetRecord(m_id)); }
+
+                const_iterator& operator++() { m_id = m_storage->NextEntry(m_id); return *this; }
+
+                bool operator==(const_iterator const& other) const { return m_id == other.m_id; }
+                bool operator!=(const_iterator const& other) const { return m_id != other.m_id; }
+
+                uint32 GetId() const { return m_id; }
+
+            private:
+                SQLStorage const* m_storage;
+                uint32 m_id;
+        };
+
+        template<class T>
+            const_iterator<T> begin() const { return const_iterator<T>(*this, MaxEntry && GetRecord(0) ? 0 : NextEntry(0)); }
+        template<class T>
+            const_iterator<T> end() const { return const_iterator<T>(*this, MaxEntry); }
+
         uint32 RecordCount;
         uint32 MaxEntry;
         uint32 iNumFields;
@@ -69,7 +99,30 @@ class SQLStorage
         void Free();
 
         void EraseEntry(uint32 id);
+
+        // first existed entry id after id, MaxEntry if none
+        uint32 NextEntry(uint32 id) const;
+
+        // record at id < MaxEntry or NULL, unlike LookupEntry also return record with id 0
+        char const* GetRecord(uint32 id) const
+        {
+            char** block = pIndex[id >> INDEX_BLOCK_BITS];
+            return block ? block[id & INDEX_BLOCK_MASK] : NULL;
+        }
     private:
+        // entry index is two level sparse array: blocks of INDEX_BLOCK_SIZE record pointers are allocated
+        // only for id ranges with records, so ids with large gaps don't cost pointer per missing id
+        enum
+        {
+            INDEX_BLOCK_BITS = 8,
+            INDEX_BLOCK_SIZE = 1 << INDEX_BLOCK_BITS,
+            INDEX_BLOCK_MASK = INDEX_BLOCK_SIZE - 1
+        };
+
+        static char*** CreateIndex(uint32 maxEntry);
+        static void SetIndexEntry(char*** index, uint32 id, char* record);
+        static void FreeIndex(char*** index, uint32 maxEntry);
+
         void init(const char * _entry_field, const char * sqlname)
         {
             entry_field = _entry_field;
@@ -80,7 +133,7 @@ class SQLStorage
             MaxEntry = 0;
         }
 
-        char** pIndex;
+        char*** pIndex;
 
         char *data;
         const char *src_format;
@@ -109,6 +162,10 @@ struct SQLStorageLoaderBase
             void convert_from_str(uint32 field_pos, char* src, D& dst);
         void convert_str_to_str(uint32 field_pos, char* src, char *&dst);
     private:
+        // fill storage from snapshot rows instead of SELECT
+        void LoadSnapshot(SQLStorage &store, ByteBuffer& rows, uint32 maxEntry);
+        static uint32 GetRecordSize(SQLStorage const& store);
+
         template<class V>
             void storeValue(V value, SQLStorage &store, char *p, uint32 x, uint32 &offset);
         void storeValue(char const* value, SQLStorage &store, char *p, uint32 x, uint32 &offset);
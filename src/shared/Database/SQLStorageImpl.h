@@ -22,6 +22,7 @@
 #include "ProgressBar.h"
 #include "Log.h"
 #include "DBCFileLoader.h"
+#include "SQLStorageSnapshot.h"
 
 template<class T>
 template<class S, class D>
@@ -143,7 +144,15 @@ void SQLStorageLoaderBase<T>::storeValue(char const* value, SQLStorage &store, c
 template<class T>
 void SQLStorageLoaderBase<T>::Load(SQLStorage &store, bool error_at_empty /*= true*/)
 {
+    SQLStorageSnapshot snapshot(store.table, store.entry_field, store.src_format);
+
     uint32 maxi;
+    if (snapshot.Read(maxi, store.RecordCount))
+    {
+        LoadSnapshot(store, snapshot.Data(), maxi);
+        return;
+    }
+
     Field *fields;
     QueryResult *result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.entry_field, store.table);
     if(!result)
@@ -179,7 +188,6 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store, bool error_at_empty /*= tr
         return;
     }
 
-    uint32 recordsize = 0;
     uint32 offset = 0;
 
     if(store.iNumFields != result->GetFieldCount())
@@ -191,61 +199,74 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store, bool error_at_empty /*= tr
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    //get struct size
-    for(uint32 x = 0; x < store.iNumFields; ++x)
-    {
-        switch(store.dst_format[x])
-        {
-            case FT_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case FT_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_INT:
-                recordsize += sizeof(uint32); break;
-            case FT_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_STRING:
-                recordsize += sizeof(char*);  break;
-            case FT_NA:
-            case FT_NA_BYTE:
-                break;
-            case FT_IND:
-            case FT_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
+    uint32 recordsize = GetRecordSize(store);
 
-    char** newIndex=new char*[maxi];
-    memset(newIndex,0,maxi*sizeof(char*));
+    char*** newIndex = SQLStorage::CreateIndex(maxi);
 
     char * _data= new char[store.RecordCount *recordsize];
     uint32 count = 0;
+
+    // source values are also collected for snapshot, used at next load while table not changed
+    bool writeSnapshot = snapshot.IsEnabled();
+    ByteBuffer& rows = snapshot.Data();
+    if (writeSnapshot)
+        snapshot.Create();
+
     BarGoLink bar(store.RecordCount);
     do
     {
         fields = result->Fetch();
         bar.step();
         char *p=(char*)&_data[recordsize*count];
-        newIndex[fields[0].GetUInt32()]=p;
+        SQLStorage::SetIndexEntry(newIndex, fields[0].GetUInt32(), p);
+
+        if (writeSnapshot)
+            rows << fields[0].GetUInt32();
 
         offset=0;
         for(uint32 x = 0; x < store.iNumFields; x++)
             switch(store.src_format[x])
             {
                 case FT_LOGIC:
-                    storeValue((bool)(fields[x].GetUInt32() > 0), store, p, x, offset); break;
+                {
+                    bool value = fields[x].GetUInt32() > 0;
+                    storeValue(value, store, p, x, offset);
+                    if (writeSnapshot)
+                        rows << uint8(value);
+                    break;
+                }
                 case FT_BYTE:
-                    storeValue((char)fields[x].GetUInt8(), store, p, x, offset); break;
+                {
+                    char value = (char)fields[x].GetUInt8();
+                    storeValue(value, store, p, x, offset);
+                    if (writeSnapshot)
+                        rows << uint8(value);
+                    break;
+                }
                 case FT_INT:
-                    storeValue((uint32)fields[x].GetUInt32(), store, p, x, offset); break;
+                {
+                    uint32 value = fields[x].GetUInt32();
+                    storeValue(value, store, p, x, offset);
+                    if (writeSnapshot)
+                        rows << value;
+                    break;
+                }
                 case FT_FLOAT:
-                    storeValue((float)fields[x].GetFloat(), store, p, x, offset); break;
+                {
+                    float value = fields[x].GetFloat();
+                    storeValue(value, store, p, x, offset);
+                    if (writeSnapshot)
+                        rows << value;
+                    break;
+                }
                 case FT_STRING:
-                    storeValue((char const*)fields[x].GetString(), store, p, x, offset); break;
+                {
+                    char const* value = fields[x].GetString();
+                    storeValue(value, store, p, x, offset);
+                    if (writeSnapshot)
+                        rows << uint8(value ? 1 : 0) << (value ? value : "");
+                    break;
+                }
                 case FT_NA:
                 case FT_NA_BYTE:
                     break;
@@ -264,6 +285,100 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store, bool error_at_empty /*= tr
     store.pIndex = newIndex;
     store.MaxEntry = maxi;
     store.data = _data;
+
+    if (writeSnapshot)
+        snapshot.Write(maxi, count);
+}
+
+template<class T>
+void SQLStorageLoaderBase<T>::LoadSnapshot(SQLStorage &store, ByteBuffer& rows, uint32 maxEntry)
+{
+    uint32 recordsize = GetRecordSize(store);
+
+    char*** newIndex = SQLStorage::CreateIndex(maxEntry);
+
+    char* _data = new char[store.RecordCount*recordsize];
+
+    std::string str;
+
+    BarGoLink bar(store.RecordCount);
+    for (uint32 count = 0; count < store.RecordCount; ++count)
+    {
+        bar.step();
+        char* p = &_data[recordsize*count];
+        SQLStorage::SetIndexEntry(newIndex, rows.read<uint32>(), p);
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < store.iNumFields; ++x)
+            switch(store.src_format[x])
+            {
+                case FT_LOGIC:
+                    storeValue(rows.read<uint8>() != 0, store, p, x, offset); break;
+                case FT_BYTE:
+                    storeValue(rows.read<char>(), store, p, x, offset); break;
+                case FT_INT:
+                    storeValue(rows.read<uint32>(), store, p, x, offset); break;
+                case FT_FLOAT:
+                    storeValue(rows.read<float>(), store, p, x, offset); break;
+                case FT_STRING:
+                {
+                    bool isNull = rows.read<uint8>() == 0;
+                    rows >> str;
+                    storeValue(isNull ? (char const*)NULL : str.c_str(), store, p, x, offset);
+                    break;
+                }
+                case FT_NA:
+                case FT_NA_BYTE:
+                    break;
+                case FT_IND:
+                case FT_SORT:
+                    assert(false && "SQL storage not have sort field types");
+                    break;
+                default:
+                    assert(false && "unknown format character");
+            }
+    }
+
+    store.pIndex = newIndex;
+    store.MaxEntry = maxEntry;
+    store.data = _data;
+
+    sLog.outString("%s loaded from snapshot", store.table);
+}
+
+template<class T>
+uint32 SQLStorageLoaderBase<T>::GetRecordSize(SQLStorage const& store)
+{
+    uint32 recordsize = 0;
+
+    for(uint32 x = 0; x < store.iNumFields; ++x)
+    {
+        switch(store.dst_format[x])
+        {
+            case FT_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case FT_BYTE:
+                recordsize += sizeof(char);   break;
+            case FT_INT:
+                recordsize += sizeof(uint32); break;
+            case FT_FLOAT:
+                recordsize += sizeof(float);  break;
+            case FT_STRING:
+                recordsize += sizeof(char*);  break;
+            case FT_NA:
+            case FT_NA_BYTE:
+                break;
+            case FT_IND:
+            case FT_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+
+    return recordsize;
 }
 
 #endif
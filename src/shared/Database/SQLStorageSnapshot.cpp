@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+#define SNAPSHOT_MAGIC      0x534E5153                      // 'SQNS'
+#define SNAPSHOT_VERSION    2
+
+std::string SQLStorageSnapshot::m_directory;
+
+void SQLStorageSnapshot::SetDirectory(std::string const& directory)
+{
+    m_directory = directory;
+}
+
+SQLStorageSnapshot::SQLStorageSnapshot(char const* table, char const* entryField, char const* format) :
+    m_format(format), m_headerSize(0)
+{
+    if (m_directory.empty())
+        return;
+
+    m_fileName = m_directory + table + ".snapshot";
+
+    // last applied world db update, changed by every sql update
+    QueryResult* result = WorldDatabase.Query("SELECT COLUMN_NAME FROM information_schema.COLUMNS "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = 'db_version' AND COLUMN_NAME LIKE 'required%'");
+    if (!result)
+        return;
+
+    std::string dbVersion = (*result)[0].GetCppString();
+    delete result;
+
+    // table metadata, no table scan; can be cached by server (information_schema_stats_expiry at MySQL 8)
+    // and NULL is unknown time (InnoDB before 5.7 or after server restart), snapshot not used then
+    result = WorldDatabase.PQuery("SELECT UNIX_TIMESTAMP(UPDATE_TIME) FROM information_schema.TABLES "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '%s'", table);
+    if (!result)
+        return;
+
+    bool unknownTime = (*result)[0].IsNULL();
+    std::string updateTime = (*result)[0].GetCppString();
+    delete result;
+
+    if (unknownTime)
+        return;
+
+    // row count and max entry are not cached, detect added and deleted rows in cached update time period
+    result = WorldDatabase.PQuery("SELECT COUNT(*), MAX(%s) FROM %s", entryField, table);
+    if (!result)
+        return;
+
+    std::string rows = (*result)[0].GetCppString() + ":" + (*result)[1].GetCppString();
+    delete result;
+
+    m_version = dbVersion + ":" + updateTime + ":" + rows;
+}
+
+bool SQLStorageSnapshot::Read(uint32& maxEntry, uint32& recordCount)
+{
+    if (!IsEnabled())
+        return false;
+
+    FILE* file = fopen(m_fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    m_data.clear();
+
+    uint8 buffer[0x4000];
+    while (size_t count = fread(buffer, 1, sizeof(buffer), file))
+        m_data.append(buffer, count);
+
+    fclose(file);
+
+    try
+    {
+        uint32 magic, version, payloadSize;
+        std::string format, tableVersion;
+
+        m_data >> magic >> version;
+        if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+            return false;
+
+        m_data >> format >> tableVersion >> maxEntry >> recordCount >> payloadSize;
+
+        if (format != m_format || tableVersion != m_version)
+        {
+            sLog.outString("Snapshot %s is outdated, will be recreated", m_fileName.c_str());
+            return false;
+        }
+
+        // not completely written file
+        if (payloadSize != m_data.size() - m_data.rpos())
+            return false;
+    }
+    catch (ByteBufferException&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void SQLStorageSnapshot::Create()
+{
+    m_data.clear();
+    m_data << uint32(SNAPSHOT_MAGIC) << uint32(SNAPSHOT_VERSION);
+    m_data << m_format << m_version;
+    m_data << uint32(0) << uint32(0) << uint32(0);          // max entry, record count and payload size, set at write
+    m_headerSize = m_data.wpos();
+}
+
+void SQLStorageSnapshot::Write(uint32 maxEntry, uint32 recordCount)
+{
+    m_data.put<uint32>(m_headerSize - 3 * sizeof(uint32), maxEntry);
+    m_data.put<uint32>(m_headerSize - 2 * sizeof(uint32), recordCount);
+    m_data.put<uint32>(m_headerSize - sizeof(uint32), uint32(m_data.wpos() - m_headerSize));
+
+    // write to temporary file first, so crash at write can't leave truncated snapshot with valid name
+    std::string tmpName = m_fileName + ".tmp";
+
+    FILE* file = fopen(tmpName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can't create snapshot file %s", tmpName.c_str());
+        return;
+    }
+
+    bool written = fwrite(m_data.contents(), 1, m_data.wpos(), file) == m_data.wpos();
+    written = fclose(file) == 0 && written;
+
+    if (!written)
+    {
+        sLog.outError("Can't write snapshot file %s", tmpName.c_str());
+        remove(tmpName.c_str());
+        return;
+    }
+
+    remove(m_fileName.c_str());                             // rename can't replace existed file at Windows
+    if (rename(tmpName.c_str(), m_fileName.c_str()) != 0)
+        sLog.outError("Can't rename snapshot file %s to %s", tmpName.c_str(), m_fileName.c_str());
+}
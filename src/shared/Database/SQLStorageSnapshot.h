@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLSTORAGE_SNAPSHOT_H
+#define SQLSTORAGE_SNAPSHOT_H
+
+#include "Common.h"
+#include "ByteBuffer.h"
+
+/**
+ * On-disk binary copy of SQLStorage source table rows, used instead of SELECT at next load of the table.
+ *
+ * Snapshot is valid while last applied world db update (db_version required_ field), source table
+ * update time, row count, max entry and storage source format are same as at snapshot creation,
+ * otherwise storage is loaded from SQL and snapshot is rewritten. Update time is taken from
+ * information_schema without table scan; tables without known update time (InnoDB before MySQL 5.7 or
+ * after MySQL restart) are always loaded from SQL. MySQL 8 caches update time for
+ * information_schema_stats_expiry seconds, changes of existing rows made by hand in this period (not by
+ * sql updates that change db_version) are not detected.
+ * Rows are kept in source format (before loader conversions), so custom loader conversions are applied
+ * as for SQL load. Snapshots are disabled while directory is not set.
+ *
+ * Only SQLStorage tables are covered: spawn and loot tables are loaded by own queries into own
+ * containers with per row checks, and need own snapshot format.
+ */
+class SQLStorageSnapshot
+{
+    public:
+        // ask source table version if snapshots enabled, format is storage source format
+        SQLStorageSnapshot(char const* table, char const* entryField, char const* format);
+
+        bool IsEnabled() const { return !m_version.empty(); }
+
+        // read snapshot file into Data(), false if file not exist, stale or broken
+        bool Read(uint32& maxEntry, uint32& recordCount);
+
+        // start new snapshot content, rows must be appended to Data() before Write()
+        void Create();
+        void Write(uint32 maxEntry, uint32 recordCount);
+
+        ByteBuffer& Data() { return m_data; }
+
+        // empty directory disable snapshots
+        static void SetDirectory(std::string const& directory);
+
+    private:
+        std::string m_fileName;
+        char const* m_format;
+        std::string m_version;
+        size_t m_headerSize;
+
+        ByteBuffer m_data;
+
+        static std::string m_directory;
+};
+
+#endif
@@ -20,7 +20,7 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool ping) : m_dbEngine(db), m_dbConnection(conn), m_ping(ping), m_running(true)
 {
 }
 
@@ -49,7 +49,7 @@ void SqlDelayThread::run()
 
         ProcessRequests();
 
-        if((loopCounter++) >= pingEveryLoop)
+        if(m_ping && (loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
             m_dbEngine->Ping();
@@ -36,13 +36,14 @@ class SqlDelayThread : public ACE_Based::Runnable
         SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
         Database* m_dbEngine;                               ///< Pointer to used Database engine
         SqlConnection * m_dbConnection;                     ///< Pointer to DB connection
+        bool m_ping;                                        ///< Ping all DB connections periodically
         volatile bool m_running;
 
         //process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool ping = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
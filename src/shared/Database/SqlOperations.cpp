@@ -50,16 +50,50 @@ bool SqlTransaction::Execute(SqlConnection *conn)
 
     conn->BeginTransaction();
 
+    std::vector<const SqlStmtParameters * > batch;
+
     const int nItems = m_queue.size();
-    for (int i = 0; i < nItems; ++i)
+    for (int i = 0; i < nItems; )
     {
         SqlOperation * pStmt = m_queue[i];
 
+        //consecutive requests of same prepared statement (rows of inventory, auras, spells...) executed together,
+        //for INSERT it's one multi-row request instead of request for each row
+        if(SqlPreparedRequest * pReq = dynamic_cast<SqlPreparedRequest * >(pStmt))
+        {
+            batch.clear();
+            batch.push_back(pReq->GetParams());
+
+            int j = i + 1;
+            for (; j < nItems; ++j)
+            {
+                SqlPreparedRequest * pNext = dynamic_cast<SqlPreparedRequest * >(m_queue[j]);
+                if(!pNext || pNext->GetIndex() != pReq->GetIndex())
+                    break;
+
+                batch.push_back(pNext->GetParams());
+            }
+
+            if(batch.size() > 1)
+            {
+                if(!conn->ExecuteStmtBatch(pReq->GetIndex(), &batch[0], batch.size()))
+                {
+                    conn->RollbackTransaction();
+                    return false;
+                }
+
+                i = j;
+                continue;
+            }
+        }
+
         if(!pStmt->Execute(conn))
         {
             conn->RollbackTransaction();
             return false;
         }
+
+        ++i;
     }
 
     return conn->CommitTransaction();
@@ -80,6 +114,44 @@ bool SqlPreparedRequest::Execute( SqlConnection *conn )
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+/// ---- ASYNC CONNECTIONS SYNCHRONIZATION ----
+
+void SqlSyncPoint::Signal()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_mutex);
+    if(--m_nSignals == 0)
+        m_cond.signal();
+}
+
+void SqlSyncPoint::Wait()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_mutex);
+    while(m_nSignals > 0)
+        m_cond.wait();
+}
+
+void SqlSyncPoint::Release()
+{
+    bool bLast;
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_mutex);
+        bLast = --m_nRefs == 0;
+    }
+
+    if(bLast)
+        delete this;
+}
+
+bool SqlSyncRequest::Execute(SqlConnection * /*conn*/)
+{
+    if(m_bWait)
+        m_point->Wait();
+    else
+        m_point->Signal();
+
+    return true;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection *conn)
@@ -107,16 +179,15 @@ void SqlResultQueue::Update()
     }
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback * callback, Database *db, SqlResultQueue *queue)
 {
-    if(!callback || !thread || !queue)
+    if(!callback || !db || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
     SqlQueryHolderEx *holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
-    return true;
+    return db->DelayOperation(holderEx);
 }
 
 bool SqlQueryHolder::SetQuery(size_t index, const char *sql)
@@ -127,15 +198,15 @@ bool SqlQueryHolder::SetQuery(size_t index, const char *sql)
         return false;
     }
 
-    if(m_queries[index].first != NULL)
+    if(m_queries[index].IsSet())
     {
         sLog.outError("Attempt assign query to holder index (" SIZEFMTD ") where other query stored (Old: [%s] New: [%s])",
-            index,m_queries[index].first,sql);
+            index,m_queries[index].sql ? m_queries[index].sql : "prepared statement",sql);
         return false;
     }
 
     /// not executed yet, just stored (it's not called a holder for nothing)
-    m_queries[index] = SqlResultPair(mangos_strdup(sql), (QueryResult*)NULL);
+    m_queries[index].sql = mangos_strdup(sql);
     return true;
 }
 
@@ -162,18 +233,63 @@ bool SqlQueryHolder::SetPQuery(size_t index, const char *format, ...)
     return SetQuery(index,szQuery);
 }
 
+bool SqlQueryHolder::SetStatement(size_t index, SqlStatement& stmt)
+{
+    SqlStmtParameters * params = stmt.detach();
+
+    if(m_queries.size() <= index)
+    {
+        sLog.outError("Query index (" SIZEFMTD ") out of range (size: " SIZEFMTD ") for statement: %s", index, m_queries.size(), stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        delete params;
+        return false;
+    }
+
+    if(m_queries[index].IsSet())
+    {
+        sLog.outError("Attempt assign statement to holder index (" SIZEFMTD ") where other query stored (New: [%s])",
+            index, stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        delete params;
+        return false;
+    }
+
+    if(!stmt.CheckParams(params))
+    {
+        delete params;
+        return false;
+    }
+
+    m_queries[index].stmtIndex = stmt.ID();
+    m_queries[index].params = params;
+    return true;
+}
+
+void SqlQueryHolder::FreeQuery(size_t index, bool freeResult)
+{
+    SqlHolderQuery& query = m_queries[index];
+
+    delete [] (const_cast<char*>(query.sql));
+    query.sql = NULL;
+
+    delete query.params;
+    query.params = NULL;
+
+    if(freeResult)
+    {
+        delete query.result;
+        query.result = NULL;
+    }
+}
+
 QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if(index < m_queries.size())
     {
         /// the query strings are freed on the first GetResult or in the destructor
-        if(m_queries[index].first != NULL)
-        {
-            delete [] (const_cast<char*>(m_queries[index].first));
-            m_queries[index].first = NULL;
-        }
+        if(m_queries[index].IsSet())
+            FreeQuery(index, false);
+
         /// when you get a result aways remember to delete it!
-        return m_queries[index].second;
+        return m_queries[index].result;
     }
     else
         return NULL;
@@ -183,7 +299,7 @@ void SqlQueryHolder::SetResult(size_t index, QueryResult *result)
 {
     /// store the result in the holder
     if(index < m_queries.size())
-        m_queries[index].second = result;
+        m_queries[index].result = result;
 }
 
 SqlQueryHolder::~SqlQueryHolder()
@@ -192,12 +308,8 @@ SqlQueryHolder::~SqlQueryHolder()
     {
         /// if the result was never used, free the resources
         /// results used already (getresult called) are expected to be deleted
-        if(m_queries[i].first != NULL)
-        {
-            delete [] (const_cast<char*>(m_queries[i].first));
-            if(m_queries[i].second)
-                delete m_queries[i].second;
-        }
+        if(m_queries[i].IsSet())
+            FreeQuery(i, true);
     }
 }
 
@@ -214,12 +326,14 @@ bool SqlQueryHolderEx::Execute(SqlConnection *conn)
 
     LOCK_DB_CONN(conn);
     /// we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair> &queries = m_holder->m_queries;
+    std::vector<SqlQueryHolder::SqlHolderQuery> &queries = m_holder->m_queries;
     for(size_t i = 0; i < queries.size(); i++)
     {
         /// execute all queries in the holder and pass the results
-        char const *sql = queries[i].first;
-        if(sql) m_holder->SetResult(i, conn->Query(sql));
+        if(char const *sql = queries[i].sql)
+            m_holder->SetResult(i, conn->Query(sql));
+        else if(queries[i].params)
+            m_holder->SetResult(i, conn->QueryStmt(queries[i].stmtIndex, *queries[i].params));
     }
 
     /// sync with the caller thread
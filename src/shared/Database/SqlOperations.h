@@ -22,9 +22,11 @@
 #include "Common.h"
 
 #include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
 #include "LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
+#include "SqlPreparedStatement.h"
 
 /// ---- BASE ---
 
@@ -57,11 +59,15 @@ class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation * > m_queue;
+        uint32 m_serialId;
 
     public:
-        SqlTransaction() {}
+        explicit SqlTransaction(uint32 serialId = 0) : m_serialId(serialId) {}
         ~SqlTransaction();
 
+        //transactions with same serial id are executed in order of commit, see Database::DelayOperation
+        uint32 GetSerialId() const { return m_serialId; }
+
         void DelayExecute(SqlOperation * sql)   {   m_queue.push_back(sql); }
 
         bool Execute(SqlConnection *conn);
@@ -75,11 +81,45 @@ class SqlPreparedRequest : public SqlOperation
 
         bool Execute(SqlConnection *conn);
 
+        int GetIndex() const { return m_nIndex; }
+        const SqlStmtParameters * GetParams() const { return m_param; }
+
     private:
         const int m_nIndex;
         SqlStmtParameters * m_param;
 };
 
+/// ---- ASYNC CONNECTIONS SYNCHRONIZATION ----
+
+//lets request in one delay thread wait for requests queued earlier to other delay threads
+class SqlSyncPoint
+{
+    public:
+        explicit SqlSyncPoint(int nSignals) : m_cond(m_mutex), m_nSignals(nSignals), m_nRefs(nSignals + 1) {}
+
+        void Signal();
+        void Wait();
+        //called by each sync request, last one destroys sync point
+        void Release();
+
+    private:
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_cond;
+        int m_nSignals;                                     //signals left before waiting thread can continue
+        int m_nRefs;
+};
+
+class SqlSyncRequest : public SqlOperation
+{
+    private:
+        SqlSyncPoint * m_point;
+        bool m_bWait;
+    public:
+        SqlSyncRequest(SqlSyncPoint * point, bool bWait) : m_point(point), m_bWait(bWait) {}
+        ~SqlSyncRequest() { m_point->Release(); }
+        bool Execute(SqlConnection *conn);
+};
+
 /// ---- ASYNC QUERIES ----
 
 class SqlQuery;                                             /// contains a single async query
@@ -112,17 +152,51 @@ class SqlQueryHolder
 {
     friend class SqlQueryHolderEx;
     private:
-        typedef std::pair<const char*, QueryResult*> SqlResultPair;
-        std::vector<SqlResultPair> m_queries;
+        //plain SQL query or prepared statement with bound parameters
+        struct SqlHolderQuery
+        {
+            SqlHolderQuery() : sql(NULL), stmtIndex(-1), params(NULL), result(NULL) {}
+
+            bool IsSet() const { return sql != NULL || params != NULL; }
+
+            const char* sql;
+            int stmtIndex;
+            SqlStmtParameters* params;
+            QueryResult* result;
+        };
+
+        std::vector<SqlHolderQuery> m_queries;
+
+        //free query data, and result if it was never used
+        void FreeQuery(size_t index, bool freeResult);
     public:
         SqlQueryHolder() {}
         ~SqlQueryHolder();
         bool SetQuery(size_t index, const char *sql);
         bool SetPQuery(size_t index, const char *format, ...) ATTR_PRINTF(3,4);
+        //prepared statement query, parameters bound to stmt are taken by holder
+        bool SetStatement(size_t index, SqlStatement& stmt);
+
+        //templates to simplify 1-2 parameter bindings
+        template<typename ParamType1>
+        bool SetPStatement(size_t index, SqlStatement stmt, ParamType1 param1)
+        {
+            stmt.arg(param1);
+            return SetStatement(index, stmt);
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        bool SetPStatement(size_t index, SqlStatement stmt, ParamType1 param1, ParamType2 param2)
+        {
+            stmt.arg(param1);
+            stmt.arg(param2);
+            return SetStatement(index, stmt);
+        }
+
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult *result);
-        bool Execute(MaNGOS::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue);
+        bool Execute(MaNGOS::IQueryCallback * callback, Database *db, SqlResultQueue *queue);
 };
 
 class SqlQueryHolderEx : public SqlOperation
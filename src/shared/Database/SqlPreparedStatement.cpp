@@ -18,6 +18,8 @@
 
 #include "DatabaseEnv.h"
 
+#include <iomanip>
+
 SqlStmtParameters::SqlStmtParameters( int nParams )
 {
     //reserve memory if needed
@@ -54,10 +56,8 @@ SqlStatement& SqlStatement::operator=( const SqlStatement& index )
     return *this;
 }
 
-bool SqlStatement::Execute()
+bool SqlStatement::CheckParams(const SqlStmtParameters * args) const
 {
-    SqlStmtParameters * args = detach();
-    //verify amount of bound parameters
     if(args->boundParams() != arguments())
     {
         sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
@@ -66,24 +66,45 @@ bool SqlStatement::Execute()
         return false;
     }
 
+    return true;
+}
+
+bool SqlStatement::Execute()
+{
+    SqlStmtParameters * args = detach();
+    if(!CheckParams(args))
+    {
+        delete args;
+        return false;
+    }
+
     return m_pDB->ExecuteStmt(m_index, args);
 }
 
 bool SqlStatement::DirectExecute()
 {
     SqlStmtParameters * args = detach();
-    //verify amount of bound parameters
-    if(args->boundParams() != arguments())
+    if(!CheckParams(args))
     {
-        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
-        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
-        MANGOS_ASSERT(false);
+        delete args;
         return false;
     }
 
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+QueryResult* SqlStatement::Query()
+{
+    SqlStmtParameters * args = detach();
+    if(!CheckParams(args))
+    {
+        delete args;
+        return NULL;
+    }
+
+    return m_pDB->QueryStmt(m_index, args);
+}
+
 //////////////////////////////////////////////////////////////////////////
 SqlPlainPreparedStatement::SqlPlainPreparedStatement( const std::string& fmt, SqlConnection& conn ) : SqlPreparedStatement(fmt, conn)
 {
@@ -134,6 +155,14 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
+QueryResult* SqlPlainPreparedStatement::query()
+{
+    if(m_szPlainRequest.empty())
+        return NULL;
+
+    return m_pConn.Query(m_szPlainRequest.c_str());
+}
+
 void SqlPlainPreparedStatement::DataToString( const SqlStmtFieldData& data, std::ostringstream& fmt )
 {
     switch (data.type())
@@ -147,8 +176,9 @@ void SqlPlainPreparedStatement::DataToString( const SqlStmtFieldData& data, std:
         case FIELD_I16:     fmt << "'" << int32(data.toInt16()) << "'";     break;
         case FIELD_I32:     fmt << "'" << data.toInt32() << "'";            break;
         case FIELD_I64:     fmt << "'" << data.toInt64() << "'";            break;
-        case FIELD_FLOAT:   fmt << "'" << data.toFloat() << "'";            break;
-        case FIELD_DOUBLE:  fmt << "'" << data.toDouble() << "'";           break;
+        // enough digits to read back the same binary value, default stream precision is 6
+        case FIELD_FLOAT:   fmt << "'" << std::setprecision(9) << data.toFloat() << "'";    break;
+        case FIELD_DOUBLE:  fmt << "'" << std::setprecision(17) << data.toDouble() << "'";  break;
         case FIELD_STRING:
         {
             std::string tmp = data.toStr();
@@ -207,6 +207,10 @@ class MANGOS_DLL_SPEC SqlStatement
         bool Execute();
         bool DirectExecute();
 
+        //execute SELECT statement synchronously, result rows have typed values for DBMS with binary protocol
+        //NULL if result set is empty, same as for Database::Query()
+        QueryResult* Query();
+
         //templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
         bool PExecute(ParamType1 param1)
@@ -242,6 +246,41 @@ class MANGOS_DLL_SPEC SqlStatement
             return Execute();
         }
 
+        //templates to simplify 1-4 parameter bindings for queries
+        template<typename ParamType1>
+        QueryResult* PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3, typename ParamType4>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3, ParamType4 param4)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            arg(param4);
+            return Query();
+        }
+
         //bind parameters with specified type
         void addBool(bool var) { arg(var); }
         void addUInt8(uint8 var) { arg(var); }
@@ -261,9 +300,13 @@ class MANGOS_DLL_SPEC SqlStatement
     protected:
         //don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        //query holder takes bound parameters for async execution
+        friend class SqlQueryHolder;
         SqlStatement(const SqlStatementID& index, Database& db) : m_index(index), m_pDB(&db), m_pParams(NULL) {}
 
     private:
+        //verify amount of bound parameters
+        bool CheckParams(const SqlStmtParameters * args) const;
 
         SqlStmtParameters * get()
         {
@@ -314,6 +357,8 @@ class MANGOS_DLL_SPEC SqlPreparedStatement
 
         //execute statement w/o result set
         virtual bool execute() = 0;
+        //execute statement with result set, NULL if result set is empty
+        virtual QueryResult* query() = 0;
 
     protected:
         SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) : m_szFmt(fmt), m_nParams(0), m_nColumns(0), m_bPrepared(false), m_bIsQuery(false), m_pConn(conn) {}
@@ -340,6 +385,10 @@ class MANGOS_DLL_SPEC SqlPlainPreparedStatement : public SqlPreparedStatement
         virtual void bind(const SqlStmtParameters& holder);
 
         virtual bool execute();
+        virtual QueryResult* query();
+
+        //SQL request with bound parameters
+        const std::string& plainRequest() const { return m_szPlainRequest; }
 
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt);
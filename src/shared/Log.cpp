@@ -23,12 +23,16 @@
 #include "Util.h"
 #include "ByteBuffer.h"
 #include "ProgressBar.h"
+#include "LogWriter.h"
 
 #include <stdarg.h>
 #include <fstream>
 #include <iostream>
 
 #include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_time.h"
+
+#define LOG_LINE_BUFFER_SIZE 4096
 
 INSTANTIATE_SINGLETON_1( Log );
 
@@ -64,11 +68,42 @@ const int LogType_count = int(LogError) +1;
 
 Log::Log() :
     raLogfile(NULL), logfile(NULL), gmLogfile(NULL), charLogfile(NULL),
-    dberLogfile(NULL), m_colored(false), m_includeTime(false), m_gmlog_per_account(false)
+    dberLogfile(NULL), worldLogfile(NULL), m_colored(false), m_includeTime(false), m_gmlog_per_account(false),
+    m_writer(NULL), m_writerThread(NULL)
 {
     Initialize();
 }
 
+Log::~Log()
+{
+    // write all queued records before files closing
+    stopAsyncWriter();
+
+    if( logfile != NULL )
+        fclose(logfile);
+    logfile = NULL;
+
+    if( gmLogfile != NULL )
+        fclose(gmLogfile);
+    gmLogfile = NULL;
+
+    if (charLogfile != NULL)
+        fclose(charLogfile);
+    charLogfile = NULL;
+
+    if( dberLogfile != NULL )
+        fclose(dberLogfile);
+    dberLogfile = NULL;
+
+    if (raLogfile != NULL)
+        fclose(raLogfile);
+    raLogfile = NULL;
+
+    if (worldLogfile != NULL)
+        fclose(worldLogfile);
+    worldLogfile = NULL;
+}
+
 void Log::InitColors(const std::string& str)
 {
     if (str.empty())
@@ -277,6 +312,40 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    if (sConfig.GetBoolDefault("LogAsync", false))
+        startAsyncWriter();
+}
+
+void Log::startAsyncWriter()
+{
+    if (m_writer)
+        return;
+
+    uint32 bufferSize = sConfig.GetIntDefault("LogAsync.BufferSize", 64*1024);
+    LogFullPolicy policy = sConfig.GetIntDefault("LogAsync.FullPolicy", LOG_FULL_DROP) ? LOG_FULL_BLOCK : LOG_FULL_DROP;
+
+    m_writer = new LogWriter(bufferSize, policy, logfile);
+    // own reference, writer must live while other threads can log
+    m_writer->incReference();
+    m_writerThread = new ACE_Based::Thread(m_writer);
+}
+
+void Log::stopAsyncWriter()
+{
+    if (!m_writer)
+        return;
+
+    // later records written directly, writer drain all buffers at exit
+    LogWriter* writer = m_writer;
+    m_writer = NULL;
+
+    writer->Stop();
+    m_writerThread->wait();
+    delete m_writerThread;
+    m_writerThread = NULL;
+
+    writer->decReference();
 }
 
 FILE* Log::openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode)
@@ -307,17 +376,88 @@ FILE* Log::openGmlogPerAccount(uint32 account)
     return fopen(namebuf, "a");
 }
 
-void Log::outTimestamp(FILE* file)
+size_t Log::formatTimestamp(char* buf, size_t size)
 {
     time_t t = time(NULL);
-    tm* aTm = localtime(&t);
+    tm aTm;
+    ACE_OS::localtime_r(&t, &aTm);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
     //       DD     day (2 digits 01-31)
     //       HH     hour (2 digits 00-23)
     //       MM     minutes (2 digits 00-59)
     //       SS     seconds (2 digits 00-59)
-    fprintf(file,"%-4d-%02d-%02d %02d:%02d:%02d ",aTm->tm_year+1900,aTm->tm_mon+1,aTm->tm_mday,aTm->tm_hour,aTm->tm_min,aTm->tm_sec);
+    int len = snprintf(buf, size, "%-4d-%02d-%02d %02d:%02d:%02d ",aTm.tm_year+1900,aTm.tm_mon+1,aTm.tm_mday,aTm.tm_hour,aTm.tm_min,aTm.tm_sec);
+    return len > 0 && size_t(len) < size ? size_t(len) : 0;
+}
+
+void Log::outTimestamp(FILE* file)
+{
+    char buf[32];
+    size_t len = formatTimestamp(buf, sizeof(buf));
+    fwrite(buf, 1, len, file);
+}
+
+void Log::writeFile(FILE* file, char const* data, size_t len)
+{
+    if (m_writer)
+        m_writer->Write(file, data, uint32(len));
+    else
+    {
+        fwrite(data, 1, len, file);
+        fflush(file);
+    }
+}
+
+void Log::outFile(FILE* file, char const* prefix, char const* str, ...)
+{
+    va_list ap;
+    va_start(ap, str);
+    voutFile(file, prefix, str, ap);
+    va_end(ap);
+}
+
+void Log::voutFile(FILE* file, char const* prefix, char const* str, va_list ap)
+{
+    // line formatted once in caller thread and passed to file (or async writer) by single write
+    char buf[LOG_LINE_BUFFER_SIZE];
+    size_t len = formatTimestamp(buf, sizeof(buf));
+    if (prefix)
+    {
+        size_t prefixLen = std::min(strlen(prefix), sizeof(buf) / 2);
+        memcpy(buf + len, prefix, prefixLen);
+        len += prefixLen;
+    }
+
+    va_list ap2;
+    va_copy(ap2, ap);
+
+    size_t avail = sizeof(buf) - len;
+    int textLen = vsnprintf(buf + len, avail, str, ap);
+    if (textLen >= 0 && size_t(textLen) < avail)
+    {
+        len += textLen;
+        buf[len++] = '\n';
+        writeFile(file, buf, len);
+    }
+    else if (textLen >= 0)
+    {
+        // too long line, format again to heap buffer of real size
+        std::string line(buf, len);
+        line.resize(len + textLen + 1);
+        vsnprintf(&line[len], textLen + 1, str, ap2);
+        line[len + textLen] = '\n';
+        writeFile(file, line.data(), line.size());
+    }
+    else
+    {
+        // some platforms can't report real size, write truncated line
+        len = sizeof(buf) - 1;
+        buf[len++] = '\n';
+        writeFile(file, buf, len);
+    }
+
+    va_end(ap2);
 }
 
 void Log::outTime()
@@ -354,11 +494,7 @@ void Log::outString()
         outTime();
     printf( "\n" );
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
+        outFile(logfile, NULL, "%s", "");
 
     fflush(stdout);
 }
@@ -387,14 +523,9 @@ void Log::outString( const char * str, ... )
 
     if (logfile)
     {
-        outTimestamp(logfile);
-
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n" );
+        voutFile(logfile, NULL, str, ap);
         va_end(ap);
-
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -423,15 +554,9 @@ void Log::outError( const char * err, ... )
     fprintf( stderr, "\n" );
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:" );
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        voutFile(logfile, "ERROR:", err, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
     }
 
     fflush(stderr);
@@ -445,18 +570,10 @@ void Log::outErrorDb()
     fprintf( stderr, "\n" );
 
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n" );
-        fflush(logfile);
-    }
+        outFile(logfile, "ERROR:", "%s", "");
 
     if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n" );
-        fflush(dberLogfile);
-    }
+        outFile(dberLogfile, NULL, "%s", "");
 
     fflush(stderr);
 }
@@ -485,28 +602,16 @@ void Log::outErrorDb( const char * err, ... )
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:" );
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        voutFile(logfile, "ERROR:", err, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
     }
 
     if (dberLogfile)
     {
-        outTimestamp(dberLogfile);
-
-        va_list ap;
         va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
+        voutFile(dberLogfile, NULL, err, ap);
         va_end(ap);
-
-        fprintf(dberLogfile, "\n" );
-        fflush(dberLogfile);
     }
 
     fflush(stderr);
@@ -539,12 +644,9 @@ void Log::outBasic( const char * str, ... )
     if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n" );
+        voutFile(logfile, NULL, str, ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -577,15 +679,10 @@ void Log::outDetail( const char * str, ... )
 
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        voutFile(logfile, NULL, str, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -617,15 +714,10 @@ void Log::outDebug( const char * str, ... )
 
     if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        voutFile(logfile, NULL, str, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -658,12 +750,9 @@ void Log::outCommand( uint32 account, const char * str, ... )
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n" );
+        voutFile(logfile, NULL, str, ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     if (m_gmlog_per_account)
@@ -682,12 +771,9 @@ void Log::outCommand( uint32 account, const char * str, ... )
     else if (gmLogfile)
     {
         va_list ap;
-        outTimestamp(gmLogfile);
         va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n" );
+        voutFile(gmLogfile, NULL, str, ap);
         va_end(ap);
-        fflush(gmLogfile);
     }
 
     fflush(stdout);
@@ -702,12 +788,9 @@ void Log::outChar(const char * str, ... )
     if (charLogfile)
     {
         va_list ap;
-        outTimestamp(charLogfile);
         va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n" );
+        voutFile(charLogfile, NULL, str, ap);
         va_end(ap);
-        fflush(charLogfile);
     }
 }
 
@@ -716,31 +799,49 @@ void Log::outWorldPacketDump( uint32 socket, uint32 opcode, char const* opcodeNa
     if (!worldLogfile)
         return;
 
-    outTimestamp(worldLogfile);
+    static char const hexDigits[] = "0123456789ABCDEF";
 
-    fprintf(worldLogfile,"\n%s:\nSOCKET: %u\nLENGTH: " SIZEFMTD "\nOPCODE: %s (0x%.4X)\nDATA:\n",
+    char buf[LOG_LINE_BUFFER_SIZE];
+    size_t len = formatTimestamp(buf, sizeof(buf));
+    int headerLen = snprintf(buf + len, sizeof(buf) - len, "\n%s:\nSOCKET: %u\nLENGTH: " SIZEFMTD "\nOPCODE: %s (0x%.4X)\nDATA:\n",
         incoming ? "CLIENT" : "SERVER",
         socket, packet->size(), opcodeName, opcode);
+    if (headerLen > 0)
+        len += std::min(size_t(headerLen), sizeof(buf) - len - 1);
+
+    // whole dump is one record: 3 chars per byte, line end per 16 bytes
+    std::string dump(buf, len);
+    dump.reserve(len + packet->size() * 3 + packet->size() / 16 + 3);
 
     size_t p = 0;
     while (p < packet->size())
     {
         for (size_t j = 0; j < 16 && p < packet->size(); ++j)
-            fprintf(worldLogfile, "%.2X ", (*packet)[p++]);
+        {
+            uint8 byte = (*packet)[p++];
+            dump += hexDigits[byte >> 4];
+            dump += hexDigits[byte & 0x0F];
+            dump += ' ';
+        }
 
-        fprintf(worldLogfile, "\n");
+        dump += '\n';
     }
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    dump += "\n\n";
+    writeFile(worldLogfile, dump.data(), dump.size());
 }
 
 void Log::outCharDump( const char * str, uint32 account_id, uint32 guid, const char * name )
 {
     if (charLogfile)
     {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n",account_id,guid,name,str );
-        fflush(charLogfile);
+        char buf[256];
+        int len = snprintf(buf, sizeof(buf), "== START DUMP == (account: %u guid: %u name: %s )\n",account_id,guid,name);
+
+        std::string dump(buf, len > 0 ? std::min(size_t(len), sizeof(buf) - 1) : 0);
+        dump += str;
+        dump += "\n== END DUMP ==\n";
+        writeFile(charLogfile, dump.data(), dump.size());
     }
 }
 
@@ -752,12 +853,9 @@ void Log::outRALog(    const char * str, ... )
     if (raLogfile)
     {
         va_list ap;
-        outTimestamp(raLogfile);
         va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n" );
+        voutFile(raLogfile, NULL, str, ap);
         va_end(ap);
-        fflush(raLogfile);
     }
 
     fflush(stdout);
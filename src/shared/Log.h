@@ -24,6 +24,12 @@
 
 class Config;
 class ByteBuffer;
+class LogWriter;
+
+namespace ACE_Based
+{
+    class Thread;
+}
 
 enum LogLevel
 {
@@ -90,33 +96,8 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
 {
     friend class MaNGOS::OperatorNew<Log>;
     Log();
+    ~Log();
 
-    ~Log()
-    {
-        if( logfile != NULL )
-            fclose(logfile);
-        logfile = NULL;
-
-        if( gmLogfile != NULL )
-            fclose(gmLogfile);
-        gmLogfile = NULL;
-
-        if (charLogfile != NULL)
-            fclose(charLogfile);
-        charLogfile = NULL;
-
-        if( dberLogfile != NULL )
-            fclose(dberLogfile);
-        dberLogfile = NULL;
-
-        if (raLogfile != NULL)
-            fclose(raLogfile);
-        raLogfile = NULL;
-
-        if (worldLogfile != NULL)
-            fclose(worldLogfile);
-        worldLogfile = NULL;
-    }
     public:
         void Initialize();
         void InitColors(const std::string& init_str);
@@ -156,6 +137,7 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         void SetLogFilter(LogFilters filter, bool on) { if (on) m_logFilter |= filter; else m_logFilter &= ~filter; }
         bool HasLogLevelOrHigher(LogLevel loglvl) const { return m_logLevel >= loglvl || (m_logFileLevel >= loglvl && logfile); }
         bool IsOutCharDump() const { return m_charLog_Dump; }
+        bool IsOutWorldPacketDump() const { return worldLogfile; }
         bool IsIncludeTime() const { return m_includeTime; }
 
         static void WaitBeforeContinueIfNeed();
@@ -163,6 +145,15 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         FILE* openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
 
+        static size_t formatTimestamp(char* buf, size_t size);
+        // timestamp + prefix + formatted text + line end as one record
+        void outFile(FILE* file, char const* prefix, char const* str, ...) ATTR_PRINTF(4,5);
+        void voutFile(FILE* file, char const* prefix, char const* str, va_list ap);
+        // pass to async writer if enabled, direct write otherwise
+        void writeFile(FILE* file, char const* data, size_t len);
+        void startAsyncWriter();
+        void stopAsyncWriter();
+
         FILE* raLogfile;
         FILE* logfile;
         FILE* gmLogfile;
@@ -188,6 +179,10 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         // gm log control
         bool m_gmlog_per_account;
         std::string m_gmlog_filename_format;
+
+        // async file output
+        LogWriter* m_writer;
+        ACE_Based::Thread* m_writerThread;
 };
 
 #define sLog MaNGOS::Singleton<Log>::Instance()
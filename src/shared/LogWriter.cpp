@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LogWriter.h"
+
+// atomic add is full memory barrier, so record content written by other side is visible after it
+static inline uint32 LoadPosition(ACE_Atomic_Op<ACE_Thread_Mutex, long>& pos)
+{
+    return uint32(pos += 0);
+}
+
+LogRingBuffer::LogRingBuffer(uint32 size) : m_orphan(false)
+{
+    // round up to power of 2 for cheap wrap around
+    uint32 realSize = 1024;
+    while (realSize < size)
+        realSize <<= 1;
+
+    m_data = new char[realSize];
+    m_mask = realSize - 1;
+    m_writePos = 0;
+    m_readPos = 0;
+}
+
+LogRingBuffer::~LogRingBuffer()
+{
+    delete[] m_data;
+}
+
+void LogRingBuffer::copyIn(uint32 pos, char const* data, uint32 len)
+{
+    uint32 offset = pos & m_mask;
+    uint32 first = std::min(len, GetSize() - offset);
+    memcpy(m_data + offset, data, first);
+    if (first < len)
+        memcpy(m_data, data + first, len - first);
+}
+
+void LogRingBuffer::copyOut(uint32 pos, char* data, uint32 len) const
+{
+    uint32 offset = pos & m_mask;
+    uint32 first = std::min(len, GetSize() - offset);
+    memcpy(data, m_data + offset, first);
+    if (first < len)
+        memcpy(data + first, m_data, len - first);
+}
+
+bool LogRingBuffer::Write(FILE* file, char const* data, uint32 len)
+{
+    uint32 writePos = uint32(m_writePos.value());
+    uint32 readPos = LoadPosition(m_readPos);
+
+    uint32 need = sizeof(LogRecordHeader) + len;
+    if (need > GetSize() - (writePos - readPos))
+        return false;
+
+    LogRecordHeader header;
+    header.file = file;
+    header.len = len;
+
+    copyIn(writePos, (char const*)&header, sizeof(LogRecordHeader));
+    copyIn(writePos + sizeof(LogRecordHeader), data, len);
+
+    // publish record only after its content
+    m_writePos = long(writePos + need);
+    return true;
+}
+
+bool LogRingBuffer::IsEmpty()
+{
+    return LoadPosition(m_readPos) == uint32(m_writePos.value());
+}
+
+template<typename Sink>
+void LogRingBuffer::Read(Sink& sink)
+{
+    uint32 readPos = uint32(m_readPos.value());
+    uint32 writePos = LoadPosition(m_writePos);
+
+    while (readPos != writePos)
+    {
+        LogRecordHeader header;
+        copyOut(readPos, (char*)&header, sizeof(LogRecordHeader));
+        readPos += sizeof(LogRecordHeader);
+
+        // record text can be split by buffer end
+        uint32 offset = readPos & m_mask;
+        uint32 first = std::min(header.len, GetSize() - offset);
+        sink(header.file, m_data + offset, first);
+        if (first < header.len)
+            sink(header.file, m_data, header.len - first);
+
+        readPos += header.len;
+    }
+
+    // free space for producer only after text copied
+    m_readPos = long(readPos);
+}
+
+class LogOutputSink
+{
+    public:
+        explicit LogOutputSink(LogWriter& writer) : m_writer(writer) {}
+        void operator()(FILE* file, char const* data, uint32 len) { m_writer.Append(file, data, len); }
+
+    private:
+        LogWriter& m_writer;
+};
+
+LogWriter::LogWriter(uint32 bufferSize, LogFullPolicy policy, FILE* dropReportFile) :
+    m_bufferSize(bufferSize), m_policy(policy), m_dropReportFile(dropReportFile), m_stopping(false)
+{
+    m_dropped = 0;
+}
+
+LogWriter::~LogWriter()
+{
+    // current thread storage cleaned at m_threadBuffer destruction, after buffers deleted
+    if (ThreadBuffer* threadBuffer = m_threadBuffer.ts_object())
+        threadBuffer->buffer = NULL;
+
+    for (Buffers::const_iterator itr = m_buffers.begin(); itr != m_buffers.end(); ++itr)
+        delete *itr;
+}
+
+void LogWriter::run()
+{
+    const uint32 loopSleepms = 10;
+
+    while (!m_stopping)
+    {
+        // writing can take long, continue without sleep if something was written
+        if (!Drain())
+            ACE_Based::Thread::Sleep(loopSleepms);
+    }
+
+    Drain();
+}
+
+LogRingBuffer* LogWriter::GetThreadBuffer()
+{
+    // thread storage object created at first access
+    ThreadBuffer* threadBuffer = m_threadBuffer;
+    if (!threadBuffer->buffer)
+    {
+        threadBuffer->buffer = new LogRingBuffer(m_bufferSize);
+
+        ACE_Guard<ACE_Thread_Mutex> guard(m_buffersLock);
+        m_buffers.push_back(threadBuffer->buffer);
+    }
+
+    return threadBuffer->buffer;
+}
+
+void LogWriter::Write(FILE* file, char const* data, uint32 len)
+{
+    if (!m_stopping)
+    {
+        LogRingBuffer* buffer = GetThreadBuffer();
+
+        // too long record can't fit in buffer at all, write it directly after own queued records
+        if (len > buffer->GetSize() / 2)
+        {
+            while (!buffer->IsEmpty() && !m_stopping)
+                ACE_Based::Thread::Sleep(1);
+        }
+        else
+        {
+            while (!buffer->Write(file, data, len))
+            {
+                if (m_policy == LOG_FULL_DROP)
+                {
+                    ++m_dropped;
+                    return;
+                }
+
+                if (m_stopping)
+                    break;
+
+                ACE_Based::Thread::Sleep(1);
+            }
+
+            if (!m_stopping)
+                return;
+        }
+    }
+
+    // writer thread stopped or too long record
+    ACE_Guard<ACE_Thread_Mutex> guard(m_fileLock);
+    fwrite(data, 1, len, file);
+    fflush(file);
+}
+
+void LogWriter::Append(FILE* file, char const* data, uint32 len)
+{
+    for (FileOutput::iterator itr = m_output.begin(); itr != m_output.end(); ++itr)
+    {
+        if (itr->first == file)
+        {
+            itr->second.append(data, len);
+            return;
+        }
+    }
+
+    m_output.push_back(FileOutput::value_type(file, std::string(data, len)));
+}
+
+bool LogWriter::Drain()
+{
+    LogOutputSink sink(*this);
+
+    // held until read records are written, so direct write of a thread follows its queued records
+    ACE_Guard<ACE_Thread_Mutex> fileGuard(m_fileLock);
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_buffersLock);
+
+        for (Buffers::iterator itr = m_buffers.begin(); itr != m_buffers.end();)
+        {
+            LogRingBuffer* buffer = *itr;
+
+            // check before read, owner can add last records before exit
+            bool orphan = buffer->IsOrphan();
+
+            buffer->Read(sink);
+
+            if (orphan)
+            {
+                delete buffer;
+                itr = m_buffers.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
+    if (long dropped = m_dropped.value())
+    {
+        m_dropped -= dropped;
+
+        if (m_dropReportFile)
+        {
+            char buf[100];
+            int len = snprintf(buf, sizeof(buf), "LOG: %li records dropped, log buffer full\n", dropped);
+            Append(m_dropReportFile, buf, uint32(len));
+        }
+    }
+
+    bool written = false;
+    for (FileOutput::iterator itr = m_output.begin(); itr != m_output.end(); ++itr)
+    {
+        if (itr->second.empty())
+            continue;
+
+        fwrite(itr->second.data(), 1, itr->second.size(), itr->first);
+        fflush(itr->first);
+        itr->second.clear();
+        written = true;
+    }
+
+    return written;
+}
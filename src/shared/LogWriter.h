@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_LOGWRITER_H
+#define MANGOSSERVER_LOGWRITER_H
+
+#include "Common.h"
+#include "Threading.h"
+#include <ace/Thread_Mutex.h>
+
+/**
+ * Single producer/single consumer ring of pre-formatted log records.
+ *
+ * Every record is stored as LogRecordHeader followed by the text, records can wrap
+ * around the buffer end. Positions only grow, offset in buffer is position & mask.
+ */
+class LogRingBuffer
+{
+    public:
+        explicit LogRingBuffer(uint32 size);
+        ~LogRingBuffer();
+
+        // producer side, return false if not enough free space for record
+        bool Write(FILE* file, char const* data, uint32 len);
+
+        // consumer side, call sink(file, data, len) for every stored record
+        template<typename Sink>
+        void Read(Sink& sink);
+
+        uint32 GetSize() const { return m_mask + 1; }
+
+        // producer side, true when consumer already read all stored records
+        bool IsEmpty();
+
+        // set at owner thread exit, buffer deleted by writer after last read
+        void SetOrphan() { m_orphan = true; }
+        bool IsOrphan() const { return m_orphan; }
+
+    private:
+        struct LogRecordHeader
+        {
+            FILE* file;
+            uint32 len;
+        };
+
+        void copyIn(uint32 pos, char const* data, uint32 len);
+        void copyOut(uint32 pos, char* data, uint32 len) const;
+
+        char* m_data;
+        uint32 m_mask;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_writePos;   // changed only by producer
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_readPos;    // changed only by consumer
+        bool volatile m_orphan;
+};
+
+enum LogFullPolicy
+{
+    LOG_FULL_DROP  = 0,                                     // skip record and report count of dropped records later
+    LOG_FULL_BLOCK = 1                                      // wait until writer free space
+};
+
+/**
+ * Background writer for log files.
+ *
+ * Threads format records and put them to own LogRingBuffer without locking, writer thread
+ * drain all buffers every few milliseconds and write collected text with one fwrite+fflush
+ * per file. Records of one thread keep their order, records of different threads can be
+ * reordered inside one drain cycle.
+ */
+class LogWriter : public ACE_Based::Runnable
+{
+    public:
+        LogWriter(uint32 bufferSize, LogFullPolicy policy, FILE* dropReportFile);
+        ~LogWriter();
+
+        void run();
+
+        // called from any thread
+        void Write(FILE* file, char const* data, uint32 len);
+
+        // stop writer loop, records added after are written synchronously by caller
+        void Stop() { m_stopping = true; }
+        bool IsStopping() const { return m_stopping; }
+
+    private:
+        typedef std::list<LogRingBuffer*> Buffers;
+        typedef std::vector<std::pair<FILE*, std::string> > FileOutput;
+
+        struct ThreadBuffer
+        {
+            ThreadBuffer() : buffer(NULL) {}
+            ~ThreadBuffer() { if (buffer) buffer->SetOrphan(); }
+
+            LogRingBuffer* buffer;
+        };
+
+        friend class LogOutputSink;
+
+        LogRingBuffer* GetThreadBuffer();
+        bool Drain();
+        void Append(FILE* file, char const* data, uint32 len);
+
+        uint32 m_bufferSize;
+        LogFullPolicy m_policy;
+        FILE* m_dropReportFile;
+
+        ACE_TSS<ThreadBuffer> m_threadBuffer;
+
+        ACE_Thread_Mutex m_buffersLock;                     // guard m_buffers list changes
+        Buffers m_buffers;
+
+        ACE_Thread_Mutex m_fileLock;                        // guard file writes of writer thread and direct writes
+        FileOutput m_output;                                // writer thread only
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_dropped;
+        bool volatile m_stopping;
+};
+
+#endif
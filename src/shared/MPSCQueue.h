@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <ace/Thread_Mutex.h>
+
+namespace ACE_Based
+{
+    //! Atomically replace *ptr by newval if it still equal to oldval, full memory barrier.
+    template <class T>
+    inline bool AtomicCompareAndSwap(T* volatile* ptr, T* oldval, T* newval)
+    {
+#if defined(_WIN32) && !defined(__GNUC__)
+        return InterlockedCompareExchangePointer((PVOID volatile*)ptr, newval, oldval) == oldval;
+#else
+        return __sync_bool_compare_and_swap(ptr, oldval, newval);
+#endif
+    }
+
+    /**
+     * Lock-free queue for many producer threads and one consumer thread.
+     *
+     * Producers push items to lock-free stack, consumer take whole stack at once and keep
+     * items in own FIFO list, so producers never wait for consumer and each other except
+     * compare and swap retry. Consumer functions (next, empty) must not be called concurrently,
+     * consumer thread can change over time if calls are synchronized by outer code.
+     */
+    template <class T>
+        class MPSCQueue
+    {
+        struct Node
+        {
+            T item;
+            Node* next;
+        };
+
+        //! Stack of added items, newest first. Shared with producers.
+        Node* volatile _head;
+
+        //! Consumer own items in add order.
+        Node* _first;
+
+        public:
+
+            //! Create a MPSCQueue.
+            MPSCQueue()
+                : _head(NULL), _first(NULL)
+            {
+            }
+
+            //! Destroy a MPSCQueue, not consumed items are not freed.
+            virtual ~MPSCQueue()
+            {
+                fetch();
+
+                while (_first)
+                {
+                    Node* node = _first;
+                    _first = node->next;
+                    delete node;
+                }
+            }
+
+            //! Adds an item to the queue, can be called from any thread.
+            void add(const T& item)
+            {
+                Node* node = new Node;
+                node->item = item;
+
+                Node* head;
+                do
+                {
+                    head = _head;
+                    node->next = head;
+                }
+                while (!AtomicCompareAndSwap(&_head, head, node));
+            }
+
+            //! Gets the next result in the queue, if any.
+            bool next(T& result)
+            {
+                if (!fetch())
+                    return false;
+
+                pop(result);
+                return true;
+            }
+
+            //! Gets the next result in the queue if checker accept it.
+            template<class Checker>
+            bool next(T& result, Checker& check)
+            {
+                if (!fetch())
+                    return false;
+
+                if (!check.Process(_first->item))
+                    return false;
+
+                pop(result);
+                return true;
+            }
+
+            ///! Checks if we're empty or not
+            bool empty()
+            {
+                return !fetch();
+            }
+
+        private:
+
+            //! Move added items to consumer list if it empty, return false if nothing to consume.
+            bool fetch()
+            {
+                if (_first)
+                    return true;
+
+                Node* stack;
+                do
+                {
+                    stack = _head;
+                    if (!stack)
+                        return false;
+                }
+                while (!AtomicCompareAndSwap(&_head, stack, (Node*)NULL));
+
+                // reverse stack to get add order
+                while (stack)
+                {
+                    Node* node = stack;
+                    stack = node->next;
+                    node->next = _first;
+                    _first = node;
+                }
+
+                return true;
+            }
+
+            void pop(T& result)
+            {
+                Node* node = _first;
+                _first = node->next;
+
+                result = node->item;
+                delete node;
+            }
+    };
+}
+#endif